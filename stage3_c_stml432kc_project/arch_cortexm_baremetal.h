@@ -18,6 +18,74 @@
 #define SYST_CSR_TICKINT   (1u << 1)
 #define SYST_CSR_CLKSOURCE (1u << 2)
 
+/* SysTick reload is a 24-bit field */
+#define SYST_RVR_MAX       (0x00FFFFFFu)
+
+/* ============================
+   SCB (Cortex-M)
+   ============================ */
+#define SCB_ICSR           REG32(0xE000ED04u)
+#define SCB_VTOR           REG32(0xE000ED08u)
+#define SCB_SHPR3          REG32(0xE000ED20u)
+
+/* ICSR bits */
+#define SCB_ICSR_PENDSTCLR (1u << 25)
+#define SCB_ICSR_PENDSTSET (1u << 26)
+#define SCB_ICSR_PENDSVSET (1u << 28)
+
+/* SHPR3 fields: system handler priorities (8-bit, top bits implemented) */
+#define SCB_SHPR3_PENDSV_SHIFT  (16u)
+#define SCB_SHPR3_SYSTICK_SHIFT (24u)
+
+/* ============================
+   FPU (Cortex-M4F)
+   ============================ */
+#define SCB_CPACR          REG32(0xE000ED88u)
+#define FPU_FPCCR          REG32(0xE000EF34u)
+
+/* CPACR: full access to CP10 and CP11 (the FPU) */
+#define SCB_CPACR_FPU_FULL (0xFu << 20)
+
+/* FPCCR: stack FP state on exception entry (ASPEN), but only reserve the
+ * space and save it on first FP use in the handler (LSPEN)
+ */
+#define FPU_FPCCR_LSPEN    (1u << 30)
+#define FPU_FPCCR_ASPEN    (1u << 31)
+
+/* ============================
+   NVIC (Cortex-M)
+   ============================ */
+/* One bit per IRQ, 32 per word: n = irq / 32, bit = irq % 32 */
+#define NVIC_ISER(n)       REG32(0xE000E100u + 4u * (n))
+#define NVIC_ICER(n)       REG32(0xE000E180u + 4u * (n))
+#define NVIC_ISPR(n)       REG32(0xE000E200u + 4u * (n))
+#define NVIC_ICPR(n)       REG32(0xE000E280u + 4u * (n))
+
+/* One byte per IRQ; only the top MCU_NVIC_PRIO_BITS are implemented */
+#define NVIC_IPR(irq)      (*(volatile uint8_t *)(0xE000E400u + (irq)))
+
+/* ============================
+   DWT cycle counter (Cortex-M)
+   ============================ */
+#define DEMCR              REG32(0xE000EDFCu)
+#define DWT_CTRL           REG32(0xE0001000u)
+#define DWT_CYCCNT         REG32(0xE0001004u)
+
+#define DEMCR_TRCENA       (1u << 24)
+#define DWT_CTRL_CYCCNTENA (1u << 0)
+
+/* Start the free-running core cycle counter (idempotent) */
+static inline void arch_cyccnt_enable(void)
+{
+    DEMCR    |= DEMCR_TRCENA;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+static inline uint32_t arch_cyccnt(void)
+{
+    return DWT_CYCCNT;
+}
+
 /* ============================
    IRQ control (Cortex-M)
    ============================ */
@@ -31,5 +99,115 @@ static inline void arch_irq_enable(void)
     __asm__ volatile ("cpsie i" ::: "memory");
 }
 
+/* Mask IRQs and return the previous PRIMASK, for short sections that
+ * may run with interrupts already masked (thread or ISR context).
+ */
+static inline uint32_t arch_irq_save(void)
+{
+    uint32_t primask;
+    __asm__ volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+static inline void arch_irq_restore(uint32_t primask)
+{
+    __asm__ volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+/* Active exception number: 0 in thread mode, 15 in SysTick, 16+n in IRQn */
+static inline uint32_t arch_ipsr(void)
+{
+    uint32_t ipsr;
+    __asm__ volatile ("mrs %0, ipsr" : "=r" (ipsr));
+    return ipsr;
+}
+
+/* BASEPRI masks only exceptions whose priority value is >= basepri
+ * (0 = no masking). Raise with BASEPRI_MAX: it never lowers an outer
+ * mask, so nested sections compose. Returns the previous value.
+ */
+static inline uint32_t arch_basepri_raise(uint32_t basepri)
+{
+    uint32_t prev;
+    __asm__ volatile ("mrs %0, basepri\n\tmsr basepri_max, %1\n\tisb"
+                      : "=&r" (prev) : "r" (basepri) : "memory");
+    return prev;
+}
+
+static inline void arch_basepri_restore(uint32_t basepri)
+{
+    __asm__ volatile ("msr basepri, %0" :: "r" (basepri) : "memory");
+}
+
+/* ============================
+   Exclusive access (Cortex-M)
+   ============================ */
+
+/* Load-linked / store-conditional on one word. Exception entry and return
+ * clear the monitor, so arch_strex() fails if anything ran in between:
+ * no ABA on a single core. arch_strex() returns 0 on success.
+ */
+static inline uint32_t arch_ldrex(volatile uint32_t *addr)
+{
+    uint32_t v;
+    __asm__ volatile ("ldrex %0, [%1]" : "=r" (v) : "r" (addr) : "memory");
+    return v;
+}
+
+static inline uint32_t arch_strex(volatile uint32_t *addr, uint32_t v)
+{
+    uint32_t fail;
+    __asm__ volatile ("strex %0, %2, [%1]" : "=&r" (fail) : "r" (addr), "r" (v) : "memory");
+    return fail;
+}
+
+static inline void arch_clrex(void)
+{
+    __asm__ volatile ("clrex" ::: "memory");
+}
+
+/* ============================
+   Barriers (Cortex-M)
+   ============================ */
+static inline void arch_dsb(void)
+{
+    __asm__ volatile ("dsb" ::: "memory");
+}
+
+static inline void arch_isb(void)
+{
+    __asm__ volatile ("isb" ::: "memory");
+}
+
+/* ============================
+   Sleep (Cortex-M)
+   ============================ */
+
+/* Wait for interrupt.
+ * With PRIMASK set, a pending IRQ still wakes the core but is not taken
+ * until interrupts are re-enabled.
+ */
+static inline void arch_wfi(void)
+{
+    __asm__ volatile ("dsb\n\twfi" ::: "memory");
+}
+
+/* Wait for event.
+ * Returns at once, clearing it, if the event register is set: by SEV, or
+ * by any exception taken since the last WFE. So "check for work, then
+ * WFE" needs no masking: an ISR that posts work after the check makes
+ * the WFE fall through.
+ */
+static inline void arch_wfe(void)
+{
+    __asm__ volatile ("dsb\n\twfe" ::: "memory");
+}
+
+/* Set the event register (wakes a pending WFE) */
+static inline void arch_sev(void)
+{
+    __asm__ volatile ("dsb\n\tsev" ::: "memory");
+}
+
 #endif /* ARCH_CORTEXM_BAREMETAL_H */
 
@@ -0,0 +1,88 @@
+/* arch_cortexm_dsp.h — Cortex-M4 DSP extension (packed halfword SIMD)
+ *
+ * One inline per instruction used by runtime_dsp.c. A "pair" is two q15
+ * values in one word: lo = bits 15:0, hi = bits 31:16 (the order of two
+ * consecutive halfwords in memory, little-endian).
+ *
+ * Without __ARM_FEATURE_DSP (host compiler, Cortex-M0/M3) every helper
+ * falls back to plain C with the same result bit for bit, so the kernels
+ * build and verify on the host.
+ */
+
+#ifndef ARCH_CORTEXM_DSP_H
+#define ARCH_CORTEXM_DSP_H
+
+#include <stdint.h>
+
+/* Two consecutive halfwords from any 2-byte aligned address (the M4
+ * allows unaligned LDR; this compiles to a single load)
+ */
+static inline uint32_t arch_pair_load(const int16_t *p)
+{
+    uint32_t v;
+    __builtin_memcpy(&v, p, sizeof v);
+    return v;
+}
+
+#if defined(__ARM_FEATURE_DSP)
+
+/* acc + x.lo * y.lo + x.hi * y.hi, 64-bit accumulator */
+static inline int64_t arch_smlald(uint32_t x, uint32_t y, int64_t acc)
+{
+    __asm__ ("smlald %Q0, %R0, %1, %2" : "+r" (acc) : "r" (x), "r" (y));
+    return acc;
+}
+
+/* acc + x.lo * y.hi + x.hi * y.lo (exchanged halves) */
+static inline int64_t arch_smlaldx(uint32_t x, uint32_t y, int64_t acc)
+{
+    __asm__ ("smlaldx %Q0, %R0, %1, %2" : "+r" (acc) : "r" (x), "r" (y));
+    return acc;
+}
+
+/* Clamp to the q15 range [-32768, 32767] */
+static inline int32_t arch_ssat16(int32_t x)
+{
+    int32_t r;
+    __asm__ ("ssat %0, #16, %1" : "=r" (r) : "r" (x));
+    return r;
+}
+
+/* Pair with lo = lo.lo, hi = hi.lo */
+static inline uint32_t arch_pkhbt(uint32_t lo, uint32_t hi)
+{
+    uint32_t r;
+    __asm__ ("pkhbt %0, %1, %2, lsl #16" : "=r" (r) : "r" (lo), "r" (hi));
+    return r;
+}
+
+#else /* portable C */
+
+static inline int32_t arch_pair_lo(uint32_t x) { return (int16_t)(x & 0xFFFFu); }
+static inline int32_t arch_pair_hi(uint32_t x) { return (int16_t)(x >> 16); }
+
+static inline int64_t arch_smlald(uint32_t x, uint32_t y, int64_t acc)
+{
+    return acc + (int64_t)(arch_pair_lo(x) * arch_pair_lo(y))
+               + (int64_t)(arch_pair_hi(x) * arch_pair_hi(y));
+}
+
+static inline int64_t arch_smlaldx(uint32_t x, uint32_t y, int64_t acc)
+{
+    return acc + (int64_t)(arch_pair_lo(x) * arch_pair_hi(y))
+               + (int64_t)(arch_pair_hi(x) * arch_pair_lo(y));
+}
+
+static inline int32_t arch_ssat16(int32_t x)
+{
+    return (x > 32767) ? 32767 : (x < -32768) ? -32768 : x;
+}
+
+static inline uint32_t arch_pkhbt(uint32_t lo, uint32_t hi)
+{
+    return (lo & 0xFFFFu) | (hi << 16);
+}
+
+#endif /* __ARM_FEATURE_DSP */
+
+#endif /* ARCH_CORTEXM_DSP_H */
@@ -0,0 +1,64 @@
+/* bench.c — shared plumbing for benchmark builds (make BENCH=<name>) */
+
+#include "bench.h"
+#include "board.h"
+#include "runtime.h"
+
+volatile uint32_t g_bench_done;
+
+void bench_hist_reset(bench_hist_t *h)
+{
+    bench_stat_reset(&h->stat);
+    h->p50  = 0;
+    h->p90  = 0;
+    h->p99  = 0;
+    h->p999 = 0;
+    for (uint32_t i = 0; i < BENCH_HIST_BUCKETS; i++) {
+        h->bucket[i] = 0;
+    }
+}
+
+/* Largest value that lands in bucket i */
+static uint32_t hist_upper(uint32_t i)
+{
+    if (i < 4u) {
+        return i;
+    }
+    uint32_t e = i / 4u + 1u;
+    uint32_t s = i % 4u;
+    return (uint32_t)((((uint64_t)5u + s) << (e - 2u)) - 1u);
+}
+
+/* First bucket whose running count reaches per_mille of the total */
+static uint32_t hist_percentile(const bench_hist_t *h, uint32_t per_mille)
+{
+    uint64_t rank = ((uint64_t)h->stat.count * per_mille + 999u) / 1000u;
+    uint64_t seen = 0;
+
+    for (uint32_t i = 0; i < BENCH_HIST_BUCKETS; i++) {
+        seen += h->bucket[i];
+        if ((seen >= rank) && (seen != 0u)) {
+            uint32_t upper = hist_upper(i);
+            return (upper < h->stat.max) ? upper : h->stat.max;
+        }
+    }
+    return h->stat.max;
+}
+
+void bench_hist_finish(bench_hist_t *h)
+{
+    h->p50  = hist_percentile(h, 500u);
+    h->p90  = hist_percentile(h, 900u);
+    h->p99  = hist_percentile(h, 990u);
+    h->p999 = hist_percentile(h, 999u);
+}
+
+void bench_finish(void)
+{
+    g_bench_done = 1u;
+    board_led_on();
+
+    for (;;) {
+        runtime_idle();
+    }
+}
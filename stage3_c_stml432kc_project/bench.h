@@ -0,0 +1,99 @@
+/* bench.h — on-target benchmark builds
+ *
+ * Built only with `make BENCH=<name>`: main() hands over to
+ * bench_<name>_run() once the runtime is up. Results are plain RAM
+ * structs (g_bench_*) read from the debugger; no UART, no printf.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+/* Cycle statistics accumulator */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;   /* mean = sum / count */
+} bench_stat_t;
+
+static inline void bench_stat_reset(bench_stat_t *s)
+{
+    s->count = 0;
+    s->min   = UINT32_MAX;
+    s->max   = 0;
+    s->sum   = 0;
+}
+
+static inline void bench_stat_add(bench_stat_t *s, uint32_t cycles)
+{
+    s->count++;
+    s->sum += cycles;
+    if (cycles < s->min) {
+        s->min = cycles;
+    }
+    if (cycles > s->max) {
+        s->max = cycles;
+    }
+}
+
+/* Log-scale histogram: four buckets per power of two, from 0 to 2^32.
+ * Bucket i < 4 holds exactly i; above that, bucket 4 * (e - 1) + s holds
+ * [(4 + s) << (e - 2), (5 + s) << (e - 2)), i.e. 1/(4 + s) of its lower
+ * bound wide: 25, 20, 17 and 14 % across each octave.
+ * bench_hist_finish() fills the percentiles, each the upper bound of the
+ * bucket that reaches it.
+ */
+#define BENCH_HIST_BUCKETS  (124u)
+
+typedef struct {
+    bench_stat_t stat;     /* exact count / min / max / sum */
+    uint32_t     p50;
+    uint32_t     p90;
+    uint32_t     p99;
+    uint32_t     p999;
+    uint32_t     bucket[BENCH_HIST_BUCKETS];
+} bench_hist_t;
+
+static inline uint32_t bench_hist_index(uint32_t v)
+{
+    if (v < 4u) {
+        return v;
+    }
+    uint32_t e = 31u - (uint32_t)__builtin_clz(v);
+    return 4u * (e - 1u) + ((v >> (e - 2u)) & 3u);
+}
+
+/* Single writer per histogram (one ISR or thread); no locking */
+static inline void bench_hist_add(bench_hist_t *h, uint32_t v)
+{
+    bench_stat_add(&h->stat, v);
+    h->bucket[bench_hist_index(v)]++;
+}
+
+void bench_hist_reset(bench_hist_t *h);
+void bench_hist_finish(bench_hist_t *h);
+
+/* Set when the selected benchmark has finished */
+extern volatile uint32_t g_bench_done;
+
+/* Mark results final, LED solid on, idle forever */
+void bench_finish(void) __attribute__((noreturn));
+
+/* Benchmark entry points (one per bench_<name>.c) */
+void bench_sched_run(void);
+void bench_ring_run(void);
+void bench_startup_run(void);
+void bench_clock_run(void);
+void bench_ramfunc_run(void);
+void bench_irqlat_run(void);
+void bench_log_run(void);
+void bench_jitter_run(void);
+void bench_fpu_run(void);
+void bench_dsp_run(void);
+void bench_mem_run(void);
+void bench_pool_run(void);
+void bench_event_run(void);
+
+#endif /* BENCH_H */
@@ -0,0 +1,105 @@
+/* bench_clock.c — the same workload under each clock profile
+ * (make BENCH=clock)
+ *
+ * A CRC-32 over a flash-resident table plus an integer mixing loop is run
+ * at MSI 4 MHz, MSI 16 MHz, PLL 80 MHz, and PLL 80 MHz with the flash
+ * accelerator (prefetch, I/D caches) off. Cycles show the wait-state cost;
+ * microseconds show the wall-clock win.
+ *
+ *   (gdb) p g_bench_clock
+ *
+ * speedup_x100 is wall time relative to the 4 MHz run (400 = 4.00x).
+ */
+
+#include "bench.h"
+#include "mcu.h"
+#include "init_clock.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_CLOCK_RUNS     (4u)
+#define BENCH_CLOCK_REPEAT   (8u)
+#define BENCH_CLOCK_WORDS    (1024u)
+
+typedef struct {
+    uint32_t hz[BENCH_CLOCK_RUNS];
+    uint32_t cycles[BENCH_CLOCK_RUNS];
+    uint32_t us[BENCH_CLOCK_RUNS];
+    uint32_t speedup_x100[BENCH_CLOCK_RUNS];
+    uint32_t checksum;
+    uint32_t errors;      /* runs whose result differs from the first */
+} bench_clock_t;
+
+bench_clock_t g_bench_clock;
+
+/* Flash-resident input, so wait states and the caches matter */
+static const uint32_t s_input[BENCH_CLOCK_WORDS] = { 0x12345678u, 0x9ABCDEF0u, 1u, 2u, 3u };
+
+static uint32_t crc32_word(uint32_t crc, uint32_t w)
+{
+    crc ^= w;
+    for (uint32_t b = 0; b < 32u; b++) {
+        crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return crc;
+}
+
+static uint32_t workload(void)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    uint32_t mix = 0;
+
+    for (uint32_t r = 0; r < BENCH_CLOCK_REPEAT; r++) {
+        for (uint32_t i = 0; i < BENCH_CLOCK_WORDS; i++) {
+            crc  = crc32_word(crc, s_input[i] + r);
+            mix  = (mix * 33u) ^ (crc >> 7);
+        }
+    }
+    return ~crc ^ mix;
+}
+
+static void measure(uint32_t run, uint32_t profile, uint32_t accel)
+{
+    init_clock_profile(profile);
+    if (!accel) {
+        FLASH_ACR &= ~(FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN);
+    }
+
+    uint32_t t0  = arch_cyccnt();
+    uint32_t sum = workload();
+    uint32_t cyc = arch_cyccnt() - t0;
+    uint32_t hz  = init_clock_profile_hz(profile);
+
+    if (run == 0u) {
+        g_bench_clock.checksum = sum;
+    } else if (sum != g_bench_clock.checksum) {
+        g_bench_clock.errors++;
+    }
+
+    g_bench_clock.hz[run]     = hz;
+    g_bench_clock.cycles[run] = cyc;
+    g_bench_clock.us[run]     = (uint32_t)(((uint64_t)cyc * 1000000u) / hz);
+}
+
+void bench_clock_run(void)
+{
+    /* SysTick is programmed for the boot clock; keep it out of the way */
+    arch_irq_disable();
+
+    measure(0u, CLOCK_PROFILE_MSI_4MHZ,  1u);
+    measure(1u, CLOCK_PROFILE_MSI_16MHZ, 1u);
+    measure(2u, CLOCK_PROFILE_PLL_80MHZ, 1u);
+    measure(3u, CLOCK_PROFILE_PLL_80MHZ, 0u);
+
+    /* Back to the boot profile (also restores the accelerator bits) */
+    init_clock_profile(CLOCK_PROFILE);
+
+    arch_irq_enable();
+
+    for (uint32_t run = 0; run < BENCH_CLOCK_RUNS; run++) {
+        uint32_t us = g_bench_clock.us[run];
+        g_bench_clock.speedup_x100[run] =
+            (us != 0u) ? (uint32_t)(((uint64_t)g_bench_clock.us[0] * 100u) / us) : 0u;
+    }
+
+    bench_finish();
+}
@@ -0,0 +1,66 @@
+/* bench_dsp.c — fixed-point DSP kernels on target (make BENCH=dsp)
+ *
+ * Every runtime_dsp kernel runs one block of bench_dsp_cases.h input:
+ *
+ *   check      : output checksum of the first call; `make dsp-ref` prints
+ *                the same numbers from the portable C build on the host,
+ *                so equal values mean the SIMD path is bit-exact
+ *   call       : cycles per call over BENCH_DSP_RUNS calls (IRQs masked)
+ *   per_sample : call.min * 100 / samples, i.e. cycles per sample x 100
+ *
+ * Index order is the DSP_* enum: dot, fir, decim, biquad, movavg, each
+ * as q15 then q31.
+ *
+ *   (gdb) p g_bench_dsp.kernel[2]
+ *   (gdb) p/x g_bench_dsp.kernel[2].check
+ */
+
+#include "bench.h"
+#include "bench_dsp_cases.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_DSP_RUNS  (32u)
+
+typedef struct {
+    uint32_t     check;
+    bench_stat_t call;
+    uint32_t     samples;      /* input samples per call */
+    uint32_t     per_sample;   /* cycles per sample x 100, from call.min */
+} bench_dsp_kernel_t;
+
+typedef struct {
+    bench_dsp_kernel_t kernel[DSP_CASE_COUNT];
+    uint32_t           simd;   /* 1: built with the DSP extension */
+} bench_dsp_t;
+
+bench_dsp_t g_bench_dsp;
+
+void bench_dsp_run(void)
+{
+#if defined(__ARM_FEATURE_DSP)
+    g_bench_dsp.simd = 1u;
+#endif
+    bench_dsp_setup();
+
+    for (uint32_t id = 0; id < DSP_CASE_COUNT; id++) {
+        bench_dsp_case_run(id);
+        g_bench_dsp.kernel[id].check = bench_dsp_case_check(id);
+    }
+
+    arch_irq_disable();
+    for (uint32_t id = 0; id < DSP_CASE_COUNT; id++) {
+        bench_dsp_kernel_t *k = &g_bench_dsp.kernel[id];
+
+        bench_stat_reset(&k->call);
+        for (uint32_t r = 0; r < BENCH_DSP_RUNS; r++) {
+            uint32_t t0 = arch_cyccnt();
+            bench_dsp_case_run(id);
+            bench_stat_add(&k->call, arch_cyccnt() - t0);
+        }
+        k->samples    = bench_dsp_case_samples(id);
+        k->per_sample = k->call.min * 100u / k->samples;
+    }
+    arch_irq_enable();
+
+    bench_finish();
+}
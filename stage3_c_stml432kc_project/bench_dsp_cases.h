@@ -0,0 +1,219 @@
+/* bench_dsp_cases.h — fixed inputs and one pass per runtime_dsp kernel
+ *
+ * Shared by bench_dsp.c (target, DSP instructions) and tools/dsp_ref.c
+ * (host, portable C). Each case checksums its output; the two builds
+ * must agree on every checksum.
+ */
+
+#ifndef BENCH_DSP_CASES_H
+#define BENCH_DSP_CASES_H
+
+#include <stdint.h>
+
+#include "runtime_dsp.h"
+
+#define BENCH_DSP_BLOCK    (64u)
+#define BENCH_DSP_TAPS     (31u)   /* odd: covers the single-tap tail */
+#define BENCH_DSP_DECIM    (4u)
+#define BENCH_DSP_STAGES   (2u)
+#define BENCH_DSP_AVG_LOG2 (4u)
+
+enum {
+    DSP_DOT_Q15,
+    DSP_DOT_Q31,
+    DSP_FIR_Q15,
+    DSP_FIR_Q31,
+    DSP_DECIM_Q15,
+    DSP_DECIM_Q31,
+    DSP_BIQUAD_Q15,
+    DSP_BIQUAD_Q31,
+    DSP_MOVAVG_Q15,
+    DSP_MOVAVG_Q31,
+    DSP_CASE_COUNT
+};
+
+static const char *const bench_dsp_case_name[DSP_CASE_COUNT] = {
+    "dot_q15", "dot_q31", "fir_q15", "fir_q31", "decim_q15", "decim_q31",
+    "biquad_q15", "biquad_q31", "movavg_q15", "movavg_q31",
+};
+
+/* Second-order Butterworth low-pass at fs / 10, twice, post_shift 1:
+ * b = {0.0675, 0.1349, 0.0675}, -a = {1.1430, -0.4128}, all halved.
+ */
+static const runtime_q15_t s_dsp_biquad_q15[5u * BENCH_DSP_STAGES] = {
+    1106, 2211, 1106, 18727, -6763,
+    1106, 2211, 1106, 18727, -6763,
+};
+static const runtime_q31_t s_dsp_biquad_q31[5u * BENCH_DSP_STAGES] = {
+    72477573, 144955146, 72477573, 1227286118, -443228848,
+    72477573, 144955146, 72477573, 1227286118, -443228848,
+};
+
+/* One extra sample: the dot products pair in[i] with in[i + 1] */
+static runtime_q15_t s_dsp_in_q15[BENCH_DSP_BLOCK + 1u];
+static runtime_q31_t s_dsp_in_q31[BENCH_DSP_BLOCK + 1u];
+static runtime_q15_t s_dsp_out_q15[BENCH_DSP_BLOCK];
+static runtime_q31_t s_dsp_out_q31[BENCH_DSP_BLOCK];
+static runtime_q15_t s_dsp_coef_q15[BENCH_DSP_TAPS];
+static runtime_q31_t s_dsp_coef_q31[BENCH_DSP_TAPS];
+
+RUNTIME_DSP_FIR_STATE(s_dsp_fir_q15_state, runtime_q15_t, BENCH_DSP_TAPS, BENCH_DSP_BLOCK);
+RUNTIME_DSP_FIR_STATE(s_dsp_fir_q31_state, runtime_q31_t, BENCH_DSP_TAPS, BENCH_DSP_BLOCK);
+RUNTIME_DSP_FIR_STATE(s_dsp_dec_q15_state, runtime_q15_t, BENCH_DSP_TAPS, BENCH_DSP_BLOCK);
+RUNTIME_DSP_FIR_STATE(s_dsp_dec_q31_state, runtime_q31_t, BENCH_DSP_TAPS, BENCH_DSP_BLOCK);
+static runtime_q15_t s_dsp_biquad_q15_state[4u * BENCH_DSP_STAGES];
+static runtime_q31_t s_dsp_biquad_q31_state[4u * BENCH_DSP_STAGES];
+static runtime_q15_t s_dsp_avg_q15_window[1u << BENCH_DSP_AVG_LOG2];
+static runtime_q31_t s_dsp_avg_q31_window[1u << BENCH_DSP_AVG_LOG2];
+
+static runtime_dsp_fir_q15_t    s_dsp_fir_q15;
+static runtime_dsp_fir_q31_t    s_dsp_fir_q31;
+static runtime_dsp_fir_q15_t    s_dsp_dec_q15;
+static runtime_dsp_fir_q31_t    s_dsp_dec_q31;
+static runtime_dsp_biquad_q15_t s_dsp_iir_q15;
+static runtime_dsp_biquad_q31_t s_dsp_iir_q31;
+static runtime_dsp_movavg_q15_t s_dsp_avg_q15;
+static runtime_dsp_movavg_q31_t s_dsp_avg_q31;
+
+static uint32_t bench_dsp_next(uint32_t *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed;
+}
+
+/* Full-scale noise in, small taps (sum |coef| < 1) */
+static void bench_dsp_setup(void)
+{
+    uint32_t seed = 1u;
+
+    for (uint32_t i = 0; i < BENCH_DSP_BLOCK + 1u; i++) {
+        s_dsp_in_q15[i] = (runtime_q15_t)(bench_dsp_next(&seed) >> 16);
+        s_dsp_in_q31[i] = (runtime_q31_t)bench_dsp_next(&seed);
+    }
+    for (uint32_t i = 0; i < BENCH_DSP_TAPS; i++) {
+        s_dsp_coef_q15[i] = (runtime_q15_t)((int32_t)(bench_dsp_next(&seed) >> 16) >> 5);
+        s_dsp_coef_q31[i] = (runtime_q31_t)bench_dsp_next(&seed) >> 5;
+    }
+
+    runtime_dsp_fir_q15_init(&s_dsp_fir_q15, s_dsp_coef_q15, BENCH_DSP_TAPS,
+                             s_dsp_fir_q15_state, BENCH_DSP_BLOCK);
+    runtime_dsp_fir_q31_init(&s_dsp_fir_q31, s_dsp_coef_q31, BENCH_DSP_TAPS,
+                             s_dsp_fir_q31_state, BENCH_DSP_BLOCK);
+    runtime_dsp_fir_q15_init(&s_dsp_dec_q15, s_dsp_coef_q15, BENCH_DSP_TAPS,
+                             s_dsp_dec_q15_state, BENCH_DSP_BLOCK);
+    runtime_dsp_fir_q31_init(&s_dsp_dec_q31, s_dsp_coef_q31, BENCH_DSP_TAPS,
+                             s_dsp_dec_q31_state, BENCH_DSP_BLOCK);
+    runtime_dsp_biquad_q15_init(&s_dsp_iir_q15, s_dsp_biquad_q15, BENCH_DSP_STAGES,
+                                s_dsp_biquad_q15_state, 1u);
+    runtime_dsp_biquad_q31_init(&s_dsp_iir_q31, s_dsp_biquad_q31, BENCH_DSP_STAGES,
+                                s_dsp_biquad_q31_state, 1u);
+    runtime_dsp_movavg_q15_init(&s_dsp_avg_q15, s_dsp_avg_q15_window, BENCH_DSP_AVG_LOG2);
+    runtime_dsp_movavg_q31_init(&s_dsp_avg_q31, s_dsp_avg_q31_window, BENCH_DSP_AVG_LOG2);
+}
+
+static uint32_t bench_dsp_mix(uint32_t h, uint32_t v)
+{
+    return (h ^ v) * 16777619u;
+}
+
+static uint32_t bench_dsp_sum_q15(const runtime_q15_t *v, uint32_t n)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < n; i++) {
+        h = bench_dsp_mix(h, (uint16_t)v[i]);
+    }
+    return h;
+}
+
+static uint32_t bench_dsp_sum_q31(const runtime_q31_t *v, uint32_t n)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < n; i++) {
+        h = bench_dsp_mix(h, (uint32_t)v[i]);
+    }
+    return h;
+}
+
+static uint32_t bench_dsp_sum_64(int64_t v)
+{
+    return bench_dsp_mix(bench_dsp_mix(2166136261u, (uint32_t)v),
+                         (uint32_t)((uint64_t)v >> 32));
+}
+
+/* Samples consumed by one pass of a case: the dot products run an odd
+ * length (the scalar tail) over a halfword-misaligned operand
+ */
+static uint32_t bench_dsp_case_samples(uint32_t id)
+{
+    return ((id == DSP_DOT_Q15) || (id == DSP_DOT_Q31)) ? BENCH_DSP_BLOCK - 1u
+                                                        : BENCH_DSP_BLOCK;
+}
+
+/* Results of the last pass (the dot products and the decimator's count) */
+static int64_t  s_dsp_dot;
+static uint32_t s_dsp_out_n;
+
+/* One block through one kernel. Filters carry their state into the next
+ * call, so the Nth call of a case gives the same output in every build.
+ */
+static void bench_dsp_case_run(uint32_t id)
+{
+    const uint32_t n = BENCH_DSP_BLOCK;
+
+    s_dsp_out_n = n;
+    switch (id) {
+    case DSP_DOT_Q15:
+        s_dsp_dot = runtime_dsp_dot_q15(s_dsp_in_q15, s_dsp_in_q15 + 1, n - 1u);
+        break;
+    case DSP_DOT_Q31:
+        s_dsp_dot = runtime_dsp_dot_q31(s_dsp_in_q31, s_dsp_in_q31 + 1, n - 1u);
+        break;
+    case DSP_FIR_Q15:
+        runtime_dsp_fir_q15(&s_dsp_fir_q15, s_dsp_in_q15, s_dsp_out_q15, n);
+        break;
+    case DSP_FIR_Q31:
+        runtime_dsp_fir_q31(&s_dsp_fir_q31, s_dsp_in_q31, s_dsp_out_q31, n);
+        break;
+    case DSP_DECIM_Q15:
+        s_dsp_out_n = runtime_dsp_decimate_q15(&s_dsp_dec_q15, s_dsp_in_q15, s_dsp_out_q15,
+                                               n, BENCH_DSP_DECIM);
+        break;
+    case DSP_DECIM_Q31:
+        s_dsp_out_n = runtime_dsp_decimate_q31(&s_dsp_dec_q31, s_dsp_in_q31, s_dsp_out_q31,
+                                               n, BENCH_DSP_DECIM);
+        break;
+    case DSP_BIQUAD_Q15:
+        runtime_dsp_biquad_q15(&s_dsp_iir_q15, s_dsp_in_q15, s_dsp_out_q15, n);
+        break;
+    case DSP_BIQUAD_Q31:
+        runtime_dsp_biquad_q31(&s_dsp_iir_q31, s_dsp_in_q31, s_dsp_out_q31, n);
+        break;
+    case DSP_MOVAVG_Q15:
+        runtime_dsp_movavg_q15(&s_dsp_avg_q15, s_dsp_in_q15, s_dsp_out_q15, n);
+        break;
+    case DSP_MOVAVG_Q31:
+        runtime_dsp_movavg_q31(&s_dsp_avg_q31, s_dsp_in_q31, s_dsp_out_q31, n);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Checksum of what the last bench_dsp_case_run(id) produced */
+static uint32_t bench_dsp_case_check(uint32_t id)
+{
+    switch (id) {
+    case DSP_DOT_Q15:
+    case DSP_DOT_Q31:
+        return bench_dsp_sum_64(s_dsp_dot);
+    case DSP_FIR_Q31:
+    case DSP_DECIM_Q31:
+    case DSP_BIQUAD_Q31:
+    case DSP_MOVAVG_Q31:
+        return bench_dsp_sum_q31(s_dsp_out_q31, s_dsp_out_n);
+    default:
+        return bench_dsp_sum_q15(s_dsp_out_q15, s_dsp_out_n);
+    }
+}
+
+#endif /* BENCH_DSP_CASES_H */
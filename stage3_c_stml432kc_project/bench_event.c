@@ -0,0 +1,176 @@
+/* bench_event.c — event bus costs and wake-up latency (make BENCH=event)
+ *
+ *   post     : cycles per runtime_event_post() from the thread
+ *   dispatch : cycles per event for a full queue drained in one call,
+ *              empty handler
+ *   wake     : TIM2 posts two events every BENCH_EVENT_PERIOD cycles,
+ *              one to the least urgent queue and then one to queue 0,
+ *              while the main loop sleeps in runtime_event_wait() (WFE).
+ *              Histogram of post -> handler entry for the queue 0 event.
+ *   order    : rounds where the queue 0 event was not handled before the
+ *              one posted ahead of it at lower priority (must be 0)
+ *
+ * Per-queue counters (depth, latency, drops) are in g_event_queue.
+ *
+ *   (gdb) p g_bench_event
+ *   (gdb) p g_event_queue
+ */
+
+#include "bench.h"
+#include "board.h"
+#include "mcu.h"
+#include "runtime_event.h"
+#include "runtime_irq.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_EVENT_SAMPLES  (1024u)
+#define BENCH_EVENT_PERIOD   (SYSCLK_HZ / 1000u)
+#define BENCH_EVENT_PRIO     (1u)      /* TIM2 NVIC level */
+
+#define BENCH_EVENT_LOW      (RUNTIME_EVENT_PRIOS - 1u)
+
+enum {
+    EV_NOP,
+    EV_URGENT,
+    EV_LATER,
+};
+
+typedef struct {
+    bench_stat_t post;          /* cycles per post */
+    uint32_t     dispatch;      /* cycles per event, batch of QUEUE_LEN */
+    bench_hist_t wake;          /* TIM2 post -> handler, main loop in WFE */
+    uint32_t     order;         /* priority inversions (must be 0) */
+    uint32_t     rounds;        /* TIM2 posts of each kind */
+    uint32_t     dropped;       /* posts refused (queue full) */
+} bench_event_t;
+
+bench_event_t g_bench_event;
+
+static volatile uint32_t s_rounds;
+static uint32_t          s_urgent_round;
+
+/* ============================
+   Handlers (main loop context)
+   ============================ */
+
+static void on_nop(const runtime_event_t *ev)
+{
+    (void)ev;
+}
+
+static void on_urgent(const runtime_event_t *ev)
+{
+    bench_hist_add(&g_bench_event.wake, arch_cyccnt() - ev->stamp);
+    s_urgent_round = ev->arg;
+}
+
+static void on_later(const runtime_event_t *ev)
+{
+    /* The urgent event of this round must already have run */
+    if (s_urgent_round != ev->arg) {
+        g_bench_event.order++;
+    }
+}
+
+/* ============================
+   Producer (TIM2)
+   ============================ */
+
+static void bench_timer_handler(void)
+{
+    uint32_t round = s_rounds;
+
+    TIM2_SR = ~TIM_SR_UIF;
+    if (round >= BENCH_EVENT_SAMPLES) {
+        return;
+    }
+    s_rounds = round + 1u;
+
+    if (runtime_event_post(BENCH_EVENT_LOW, EV_LATER, round) != 0) {
+        g_bench_event.dropped++;
+    }
+    if (runtime_event_post(0u, EV_URGENT, round) != 0) {
+        g_bench_event.dropped++;
+    }
+}
+
+static void timer_start(void)
+{
+    RCC_APB1ENR1 |= RCC_APB1ENR1_TIM2EN;
+    (void)RCC_APB1ENR1;
+
+    TIM2_CR1  = 0;
+    TIM2_PSC  = 0;
+    TIM2_ARR  = BENCH_EVENT_PERIOD - 1u;
+    TIM2_EGR  = TIM_EGR_UG;
+    TIM2_SR   = 0;
+    TIM2_DIER = TIM_DIER_UIE;
+
+    runtime_irq_attach(MCU_IRQ_TIM2, bench_timer_handler, BENCH_EVENT_PRIO);
+    TIM2_CR1  = TIM_CR1_CEN;
+}
+
+static void timer_stop(void)
+{
+    TIM2_CR1  = 0;
+    TIM2_DIER = 0;
+    runtime_irq_detach(MCU_IRQ_TIM2);
+}
+
+/* ============================
+   Phases
+   ============================ */
+
+static void measure_post_dispatch(void)
+{
+    uint32_t t0;
+    uint32_t t1;
+
+    bench_stat_reset(&g_bench_event.post);
+
+    for (uint32_t r = 0; r < 8u; r++) {
+        for (uint32_t i = 0; i < RUNTIME_EVENT_QUEUE_LEN; i++) {
+            t0 = arch_cyccnt();
+            (void)runtime_event_post(BENCH_EVENT_LOW, EV_NOP, i);
+            t1 = arch_cyccnt();
+            bench_stat_add(&g_bench_event.post, t1 - t0);
+        }
+
+        t0 = arch_cyccnt();
+        uint32_t n = runtime_event_dispatch(RUNTIME_EVENT_QUEUE_LEN);
+        t1 = arch_cyccnt();
+
+        uint32_t per = (t1 - t0) / n;
+        if ((r == 0u) || (per < g_bench_event.dispatch)) {
+            g_bench_event.dispatch = per;
+        }
+    }
+}
+
+static void measure_wake(void)
+{
+    bench_hist_reset(&g_bench_event.wake);
+
+    timer_start();
+    while ((s_rounds < BENCH_EVENT_SAMPLES) ||
+           (runtime_event_pending() != 0u)) {
+        runtime_event_dispatch(RUNTIME_EVENT_BATCH);
+        runtime_event_wait();
+    }
+    timer_stop();
+
+    g_bench_event.rounds = s_rounds;
+    bench_hist_finish(&g_bench_event.wake);
+}
+
+void bench_event_run(void)
+{
+    runtime_event_register(EV_NOP, on_nop);
+    runtime_event_register(EV_URGENT, on_urgent);
+    runtime_event_register(EV_LATER, on_later);
+
+    measure_post_dispatch();
+    measure_wake();
+
+    bench_finish();
+}
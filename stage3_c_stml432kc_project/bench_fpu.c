@@ -0,0 +1,210 @@
+/* bench_fpu.c — single-precision kernels, hard vs soft float (make BENCH=fpu)
+ *
+ * Two float kernels, timed in core cycles per call:
+ *
+ *   fir    : BENCH_FPU_TAPS-tap direct-form FIR over BENCH_FPU_BLOCK outputs
+ *   matmul : BENCH_FPU_DIM x BENCH_FPU_DIM matrix product
+ *
+ * Build it twice and compare:
+ *
+ *   make BENCH=fpu                  FPU instructions (build_bench_fpu/)
+ *   make BENCH=fpu FLOAT_ABI=soft   libgcc emulation (build_bench_fpu_soft/)
+ *
+ * -std=c11 keeps -ffp-contract=off, so both builds round every multiply
+ * and add the same way: the *_check result words must match bit for bit.
+ *
+ * It also shows what lazy FP state preservation (FPCCR.LSPEN, set in
+ * startup.s) saves: an integer-only handler is pended while the thread
+ * has live FP state, and pend -> entry is timed with LSPEN on and off.
+ * With LSPEN off, entry writes s0-s15 + FPSCR every time. The soft build
+ * has no FP state, so both numbers are the plain entry cost there.
+ *
+ *   (gdb) p g_bench_fpu
+ */
+
+#include "bench.h"
+#include "runtime_irq.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_FPU_TAPS     (16u)
+#define BENCH_FPU_BLOCK    (64u)
+#define BENCH_FPU_DIM      (8u)
+#define BENCH_FPU_RUNS     (32u)
+
+#define BENCH_FPU_IRQN     MCU_IRQ_WWDG   /* unused here; pended by software */
+#define BENCH_FPU_PRIO     (1u)
+#define BENCH_FPU_SAMPLES  (256u)
+
+typedef struct {
+    uint32_t     fpu;            /* 1: built with FP instructions */
+    bench_stat_t fir;            /* cycles per block */
+    bench_stat_t matmul;         /* cycles per product */
+    uint32_t     fir_macs;       /* multiply-adds per call: min / macs = */
+    uint32_t     matmul_macs;    /* cycles per MAC */
+    uint32_t     fir_check;      /* sum of result bit patterns */
+    uint32_t     matmul_check;
+    bench_stat_t isr_lazy;       /* pend -> entry, FP live, LSPEN on */
+    bench_stat_t isr_full;       /* pend -> entry, FP live, LSPEN off */
+    uint32_t     fpccr;          /* as left by startup.s */
+    uint32_t     missed;         /* handler never ran (must be 0) */
+} bench_fpu_t;
+
+bench_fpu_t g_bench_fpu;
+
+static float s_coef[BENCH_FPU_TAPS];
+static float s_in[BENCH_FPU_BLOCK + BENCH_FPU_TAPS - 1u];
+static float s_out[BENCH_FPU_BLOCK];
+
+static float s_a[BENCH_FPU_DIM][BENCH_FPU_DIM];
+static float s_b[BENCH_FPU_DIM][BENCH_FPU_DIM];
+static float s_c[BENCH_FPU_DIM][BENCH_FPU_DIM];
+
+static volatile uint32_t s_entry;
+static volatile uint32_t s_fired;
+
+/* Deterministic inputs in [-1, 1) */
+static float next_sample(uint32_t *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return (float)(int16_t)(*seed >> 16) * (1.0f / 32768.0f);
+}
+
+static __attribute__((noinline)) void fir(const float *x, const float *h,
+                                          float *y, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        float acc = 0.0f;
+        for (uint32_t k = 0; k < BENCH_FPU_TAPS; k++) {
+            acc += h[k] * x[i + k];
+        }
+        y[i] = acc;
+    }
+}
+
+static __attribute__((noinline)) void matmul(float c[BENCH_FPU_DIM][BENCH_FPU_DIM],
+                                             const float a[BENCH_FPU_DIM][BENCH_FPU_DIM],
+                                             const float b[BENCH_FPU_DIM][BENCH_FPU_DIM])
+{
+    for (uint32_t i = 0; i < BENCH_FPU_DIM; i++) {
+        for (uint32_t j = 0; j < BENCH_FPU_DIM; j++) {
+            float acc = 0.0f;
+            for (uint32_t k = 0; k < BENCH_FPU_DIM; k++) {
+                acc += a[i][k] * b[k][j];
+            }
+            c[i][j] = acc;
+        }
+    }
+}
+
+static uint32_t checksum(const float *v, uint32_t n)
+{
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        union { float f; uint32_t u; } bits = { .f = v[i] };
+        sum += bits.u;
+    }
+    return sum;
+}
+
+static void measure_kernels(void)
+{
+    arch_irq_disable();
+    for (uint32_t r = 0; r < BENCH_FPU_RUNS; r++) {
+        uint32_t t0 = arch_cyccnt();
+        fir(s_in, s_coef, s_out, BENCH_FPU_BLOCK);
+        uint32_t t1 = arch_cyccnt();
+        matmul(s_c, (const float (*)[BENCH_FPU_DIM])s_a,
+               (const float (*)[BENCH_FPU_DIM])s_b);
+        uint32_t t2 = arch_cyccnt();
+
+        bench_stat_add(&g_bench_fpu.fir, t1 - t0);
+        bench_stat_add(&g_bench_fpu.matmul, t2 - t1);
+    }
+    arch_irq_enable();
+
+    g_bench_fpu.fir_check    = checksum(s_out, BENCH_FPU_BLOCK);
+    g_bench_fpu.matmul_check = checksum(&s_c[0][0], BENCH_FPU_DIM * BENCH_FPU_DIM);
+}
+
+/* Integer only: never triggers the lazy FP save */
+static void bench_irq_handler(void)
+{
+    s_entry = arch_cyccnt();
+    s_fired = 1u;
+}
+
+static void sample_isr(bench_stat_t *stat)
+{
+    uint32_t t0;
+
+    s_fired = 0u;
+#ifdef __ARM_FP
+    /* Any FP instruction makes the thread's FP context live (CONTROL.FPCA) */
+    __asm volatile ("vmov.f32 s0, s0" ::: "s0");
+#endif
+    t0 = arch_cyccnt();
+    runtime_irq_pend(BENCH_FPU_IRQN);
+    arch_dsb();
+    arch_isb();
+
+    for (uint32_t i = 0; (i < 100u) && !s_fired; i++) { }
+    if (!s_fired) {
+        g_bench_fpu.missed++;
+        return;
+    }
+    bench_stat_add(stat, s_entry - t0);
+}
+
+static void measure_isr(void)
+{
+    uint32_t fpccr = FPU_FPCCR;
+
+    runtime_irq_attach(BENCH_FPU_IRQN, bench_irq_handler, BENCH_FPU_PRIO);
+
+    FPU_FPCCR = fpccr | FPU_FPCCR_LSPEN;
+    for (uint32_t n = 0; n < BENCH_FPU_SAMPLES; n++) {
+        sample_isr(&g_bench_fpu.isr_lazy);
+    }
+
+    FPU_FPCCR = fpccr & ~FPU_FPCCR_LSPEN;
+    for (uint32_t n = 0; n < BENCH_FPU_SAMPLES; n++) {
+        sample_isr(&g_bench_fpu.isr_full);
+    }
+
+    FPU_FPCCR = fpccr;
+    runtime_irq_detach(BENCH_FPU_IRQN);
+}
+
+void bench_fpu_run(void)
+{
+    uint32_t seed = 1u;
+
+#ifdef __ARM_FP
+    g_bench_fpu.fpu = 1u;
+#endif
+    g_bench_fpu.fpccr       = FPU_FPCCR;
+    g_bench_fpu.fir_macs    = BENCH_FPU_TAPS * BENCH_FPU_BLOCK;
+    g_bench_fpu.matmul_macs = BENCH_FPU_DIM * BENCH_FPU_DIM * BENCH_FPU_DIM;
+    bench_stat_reset(&g_bench_fpu.fir);
+    bench_stat_reset(&g_bench_fpu.matmul);
+    bench_stat_reset(&g_bench_fpu.isr_lazy);
+    bench_stat_reset(&g_bench_fpu.isr_full);
+
+    for (uint32_t i = 0; i < BENCH_FPU_TAPS; i++) {
+        s_coef[i] = next_sample(&seed);
+    }
+    for (uint32_t i = 0; i < BENCH_FPU_BLOCK + BENCH_FPU_TAPS - 1u; i++) {
+        s_in[i] = next_sample(&seed);
+    }
+    for (uint32_t i = 0; i < BENCH_FPU_DIM; i++) {
+        for (uint32_t j = 0; j < BENCH_FPU_DIM; j++) {
+            s_a[i][j] = next_sample(&seed);
+            s_b[i][j] = next_sample(&seed);
+        }
+    }
+
+    measure_kernels();
+    measure_isr();
+
+    bench_finish();
+}
@@ -0,0 +1,107 @@
+/* bench_irqlat.c — worst-case IRQ latency under critical sections
+ * (make BENCH=irqlat)
+ *
+ * A level-1 handler is pended by software at the very start of a
+ * BENCH_IRQLAT_SECTION-cycle critical section: the worst moment, since
+ * the whole section stands between request and handler. Latency is
+ * CYCCNT at pend -> CYCCNT at handler entry:
+ *
+ *   none    : no section (hardware entry cost, the floor)
+ *   primask : runtime_crit_enter()            -> waits out the section
+ *   basepri : runtime_crit_enter_prio(2)      -> preempts immediately
+ *
+ *   (gdb) p g_bench_irqlat
+ */
+
+#include "bench.h"
+#include "runtime_irq.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_IRQLAT_IRQN     MCU_IRQ_WWDG   /* unused here; pended by software */
+#define BENCH_IRQLAT_PRIO     (1u)
+#define BENCH_IRQLAT_MASK     (2u)           /* BASEPRI level for the section */
+#define BENCH_IRQLAT_SECTION  (1000u)        /* cycles spent inside a section */
+#define BENCH_IRQLAT_SAMPLES  (256u)
+
+typedef struct {
+    bench_stat_t none;
+    bench_stat_t primask;
+    bench_stat_t basepri;
+    uint32_t     section_cycles;
+    uint32_t     missed;        /* handler never ran (must be 0) */
+} bench_irqlat_t;
+
+bench_irqlat_t g_bench_irqlat;
+
+static volatile uint32_t s_entry;
+static volatile uint32_t s_fired;
+
+static void bench_irq_handler(void)
+{
+    s_entry = arch_cyccnt();
+    s_fired = 1u;
+}
+
+static void spin(uint32_t cycles)
+{
+    uint32_t t0 = arch_cyccnt();
+    while ((arch_cyccnt() - t0) < cycles) { }
+}
+
+enum { MODE_NONE, MODE_PRIMASK, MODE_BASEPRI };
+
+static void sample(bench_stat_t *stat, uint32_t mode)
+{
+    runtime_crit_t saved = 0;
+    uint32_t       t0;
+
+    s_fired = 0u;
+
+    if (mode == MODE_PRIMASK) {
+        saved = runtime_crit_enter();
+    } else if (mode == MODE_BASEPRI) {
+        saved = runtime_crit_enter_prio(BENCH_IRQLAT_MASK);
+    }
+
+    t0 = arch_cyccnt();
+    runtime_irq_pend(BENCH_IRQLAT_IRQN);
+    arch_dsb();
+    arch_isb();
+
+    if (mode != MODE_NONE) {
+        spin(BENCH_IRQLAT_SECTION);
+    }
+
+    if (mode == MODE_PRIMASK) {
+        runtime_crit_exit(saved);
+    } else if (mode == MODE_BASEPRI) {
+        runtime_crit_exit_prio(saved);
+    }
+
+    spin(100u);
+    if (!s_fired) {
+        g_bench_irqlat.missed++;
+        return;
+    }
+    bench_stat_add(stat, s_entry - t0);
+}
+
+void bench_irqlat_run(void)
+{
+    bench_stat_reset(&g_bench_irqlat.none);
+    bench_stat_reset(&g_bench_irqlat.primask);
+    bench_stat_reset(&g_bench_irqlat.basepri);
+    g_bench_irqlat.section_cycles = BENCH_IRQLAT_SECTION;
+
+    runtime_irq_attach(BENCH_IRQLAT_IRQN, bench_irq_handler, BENCH_IRQLAT_PRIO);
+
+    for (uint32_t n = 0; n < BENCH_IRQLAT_SAMPLES; n++) {
+        sample(&g_bench_irqlat.none, MODE_NONE);
+        sample(&g_bench_irqlat.primask, MODE_PRIMASK);
+        sample(&g_bench_irqlat.basepri, MODE_BASEPRI);
+    }
+
+    runtime_irq_detach(BENCH_IRQLAT_IRQN);
+
+    bench_finish();
+}
@@ -0,0 +1,206 @@
+/* bench_jitter.c — interrupt latency and jitter under load (make BENCH=jitter)
+ *
+ * Two periodic interrupts report how late their handler started, in core
+ * cycles, from the moment the hardware raised them:
+ *
+ *   systick : SysTick counts down the core clock and reloads from RVR at
+ *             the event, so RVR - CVR at entry is the delay. Measured in a
+ *             shim installed as the SysTick vector, which then runs the
+ *             real SysTick_Handler.
+ *   timer   : TIM2, 32-bit, core clock, restarts at 0 on its update event,
+ *             so CNT at entry is the delay. Period is off the 1 ms tick
+ *             so the two drift across each other.
+ *
+ * Both include the 12-cycle exception entry and the handler prologue. The
+ * thread meanwhile runs one background load per phase:
+ *
+ *   none    : a plain ALU loop
+ *   primask : runtime_irq_disable() sections of BENCH_JITTER_CRIT cycles
+ *   basepri : runtime_crit_enter_prio(BENCH_JITTER_MASK) sections; this
+ *             masks SysTick (level 2) but not TIM2 (level 1)
+ *   flash   : data reads striding across flash, missing the ART caches
+ *
+ * Results are log-scale histograms with percentiles (bench_hist_t); max
+ * minus min is the jitter.
+ *
+ *   (gdb) p g_bench_jitter.systick[1]
+ *   (gdb) p g_bench_jitter.timer[1].p99
+ */
+
+#include "bench.h"
+#include "board.h"
+#include "mcu.h"
+#include "runtime.h"
+#include "runtime_irq.h"
+#include "arch_cortexm_baremetal.h"
+
+/* Samples per source and phase (SysTick delivers 1 per ms) */
+#ifndef BENCH_JITTER_SAMPLES
+#define BENCH_JITTER_SAMPLES  (1024u)
+#endif
+
+/* Length of one critical section in the primask / basepri loads */
+#ifndef BENCH_JITTER_CRIT
+#define BENCH_JITTER_CRIT     (2000u)
+#endif
+
+/* Cycles between two sections */
+#define BENCH_JITTER_GAP      (500u)
+
+#define BENCH_JITTER_TIMER_PRIO    (1u)
+#define BENCH_JITTER_SYSTICK_PRIO  (2u)
+#define BENCH_JITTER_MASK          (2u)
+
+/* Slightly faster than the 1 kHz tick */
+#define BENCH_JITTER_TIMER_PERIOD  (SYSCLK_HZ / 1031u)
+
+/* Flash walked by the flash load */
+#define BENCH_JITTER_FLASH_BASE    (0x08000000u)
+#define BENCH_JITTER_FLASH_BYTES   (64u * 1024u)
+#define BENCH_JITTER_FLASH_STRIDE  (256u)
+
+enum {
+    LOAD_NONE,
+    LOAD_PRIMASK,
+    LOAD_BASEPRI,
+    LOAD_FLASH,
+    LOAD_COUNT
+};
+
+typedef struct {
+    bench_hist_t systick[LOAD_COUNT];  /* cycles late, per load */
+    bench_hist_t timer[LOAD_COUNT];
+    uint32_t     crit_cycles;
+    uint32_t     timer_period;
+    uint32_t     flash_sum;            /* keeps the flash reads alive */
+} bench_jitter_t;
+
+bench_jitter_t g_bench_jitter;
+
+void SysTick_Handler(void);
+
+static volatile uint32_t s_load;
+static volatile uint32_t s_systick_n;
+static volatile uint32_t s_timer_n;
+
+static void bench_systick_entry(void)
+{
+    uint32_t late = SYST_RVR - SYST_CVR;
+
+    if (s_systick_n < BENCH_JITTER_SAMPLES) {
+        bench_hist_add(&g_bench_jitter.systick[s_load], late);
+        s_systick_n++;
+    }
+    SysTick_Handler();
+}
+
+static void bench_timer_handler(void)
+{
+    uint32_t late = TIM2_CNT;
+
+    TIM2_SR = ~TIM_SR_UIF;
+    if (s_timer_n < BENCH_JITTER_SAMPLES) {
+        bench_hist_add(&g_bench_jitter.timer[s_load], late);
+        s_timer_n++;
+    }
+}
+
+static void timer_start(void)
+{
+    RCC_APB1ENR1 |= RCC_APB1ENR1_TIM2EN;
+    (void)RCC_APB1ENR1;
+
+    TIM2_CR1  = 0;
+    TIM2_PSC  = 0;
+    TIM2_ARR  = BENCH_JITTER_TIMER_PERIOD - 1u;
+    TIM2_EGR  = TIM_EGR_UG;
+    TIM2_SR   = 0;
+    TIM2_DIER = TIM_DIER_UIE;
+
+    runtime_irq_attach(MCU_IRQ_TIM2, bench_timer_handler, BENCH_JITTER_TIMER_PRIO);
+    TIM2_CR1  = TIM_CR1_CEN;
+}
+
+static void timer_stop(void)
+{
+    TIM2_CR1  = 0;
+    TIM2_DIER = 0;
+    runtime_irq_detach(MCU_IRQ_TIM2);
+}
+
+static void spin(uint32_t cycles)
+{
+    uint32_t t0 = arch_cyccnt();
+    while ((arch_cyccnt() - t0) < cycles) { }
+}
+
+static void load_step(uint32_t load)
+{
+    static uint32_t offset;
+
+    switch (load) {
+    case LOAD_PRIMASK:
+        runtime_irq_disable();
+        spin(BENCH_JITTER_CRIT);
+        runtime_irq_enable();
+        spin(BENCH_JITTER_GAP);
+        break;
+
+    case LOAD_BASEPRI: {
+        runtime_crit_t c = runtime_crit_enter_prio(BENCH_JITTER_MASK);
+        spin(BENCH_JITTER_CRIT);
+        runtime_crit_exit_prio(c);
+        spin(BENCH_JITTER_GAP);
+        break;
+    }
+
+    case LOAD_FLASH:
+        for (uint32_t i = 0; i < 64u; i++) {
+            g_bench_jitter.flash_sum +=
+                REG32(BENCH_JITTER_FLASH_BASE + offset);
+            offset = (offset + BENCH_JITTER_FLASH_STRIDE) % BENCH_JITTER_FLASH_BYTES;
+        }
+        break;
+
+    default:
+        spin(BENCH_JITTER_GAP);
+        break;
+    }
+}
+
+void bench_jitter_run(void)
+{
+    g_bench_jitter.crit_cycles  = BENCH_JITTER_CRIT;
+    g_bench_jitter.timer_period = BENCH_JITTER_TIMER_PERIOD;
+    for (uint32_t l = 0; l < LOAD_COUNT; l++) {
+        bench_hist_reset(&g_bench_jitter.systick[l]);
+        bench_hist_reset(&g_bench_jitter.timer[l]);
+    }
+
+    runtime_irq_set_systick_priority(BENCH_JITTER_SYSTICK_PRIO);
+    runtime_irq_attach_exception(15u, bench_systick_entry);
+    timer_start();
+
+    /* No idle in here: SysTick keeps its 1 ms period (tickless only
+     * stretches it from runtime_idle / delays).
+     */
+    for (uint32_t l = 0; l < LOAD_COUNT; l++) {
+        s_systick_n = BENCH_JITTER_SAMPLES;
+        s_timer_n   = BENCH_JITTER_SAMPLES;
+        s_load      = l;
+        s_systick_n = 0;
+        s_timer_n   = 0;
+
+        while ((s_systick_n < BENCH_JITTER_SAMPLES) ||
+               (s_timer_n < BENCH_JITTER_SAMPLES)) {
+            load_step(l);
+        }
+
+        bench_hist_finish(&g_bench_jitter.systick[l]);
+        bench_hist_finish(&g_bench_jitter.timer[l]);
+    }
+
+    timer_stop();
+    runtime_irq_attach_exception(15u, SysTick_Handler);
+    bench_finish();
+}
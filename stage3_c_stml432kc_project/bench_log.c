@@ -0,0 +1,75 @@
+/* bench_log.c — cost of one RUNTIME_LOG call (make BENCH=log)
+ *
+ * Times a record with 0, 1, 2 and 4 arguments, the ring drained between
+ * samples so every call takes the store path. For scale, `drain` is the
+ * consumer cost per word with runtime_log_drain().
+ *
+ *   (gdb) p g_bench_log
+ *
+ * The ring is left holding the last records; they decode with
+ * tools/log_decode.py from a RAM dump.
+ */
+
+#include "bench.h"
+#include "runtime_log.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_LOG_SAMPLES  (256u)
+
+typedef struct {
+    bench_stat_t args0;    /* cycles per RUNTIME_LOG call */
+    bench_stat_t args1;
+    bench_stat_t args2;
+    bench_stat_t args4;
+    bench_stat_t drain;    /* cycles per word drained */
+    uint32_t     dropped;  /* must be 0 */
+} bench_log_t;
+
+bench_log_t g_bench_log;
+
+static uint32_t s_words[RUNTIME_LOG_WORDS];
+
+static void drain(void)
+{
+    uint32_t t0 = arch_cyccnt();
+    uint32_t n  = runtime_log_drain(s_words, RUNTIME_LOG_WORDS);
+    uint32_t dt = arch_cyccnt() - t0;
+
+    if (n != 0u) {
+        bench_stat_add(&g_bench_log.drain, dt / n);
+    }
+}
+
+void bench_log_run(void)
+{
+    bench_stat_reset(&g_bench_log.args0);
+    bench_stat_reset(&g_bench_log.args1);
+    bench_stat_reset(&g_bench_log.args2);
+    bench_stat_reset(&g_bench_log.args4);
+    bench_stat_reset(&g_bench_log.drain);
+
+    for (uint32_t i = 0; i < BENCH_LOG_SAMPLES; i++) {
+        uint32_t t0;
+
+        drain();
+
+        t0 = arch_cyccnt();
+        RUNTIME_LOG("bench: no args");
+        bench_stat_add(&g_bench_log.args0, arch_cyccnt() - t0);
+
+        t0 = arch_cyccnt();
+        RUNTIME_LOG("bench: i=%u", (unsigned)i);
+        bench_stat_add(&g_bench_log.args1, arch_cyccnt() - t0);
+
+        t0 = arch_cyccnt();
+        RUNTIME_LOG("bench: i=%u t0=%08x", (unsigned)i, (unsigned)t0);
+        bench_stat_add(&g_bench_log.args2, arch_cyccnt() - t0);
+
+        t0 = arch_cyccnt();
+        RUNTIME_LOG("bench: %u %d %x %s", (unsigned)i, -(int)i, (unsigned)t0, "flash");
+        bench_stat_add(&g_bench_log.args4, arch_cyccnt() - t0);
+    }
+
+    g_bench_log.dropped = runtime_log_dropped();
+    bench_finish();
+}
@@ -0,0 +1,139 @@
+/* bench_mem.c — runtime mem* throughput (make BENCH=mem)
+ *
+ * Cycles per call (best of BENCH_MEM_RUNS, IRQs masked) and bytes per
+ * cycle x 100, for every size and alignment case:
+ *
+ *   op    : 0 memcpy, 1 memmove (within one buffer, dst 8 bytes above
+ *           src: the backward path), 2 memset, 3 a plain byte loop (the
+ *           baseline the runtime replaces)
+ *   align : 0 both word-aligned, 1 both at +1 (byte head, then bursts),
+ *           2 dst aligned / src at +1 (unaligned word loads)
+ *   size  : 4, 16, 64, 256, 1024, 4096 bytes
+ *
+ * Every result is checked afterwards (errors must stay 0).
+ *
+ *   (gdb) p g_bench_mem.bpc_x100[0]
+ *   (gdb) p g_bench_mem.cycles[3][0]
+ */
+
+#include <stddef.h>
+
+#include "bench.h"
+#include "runtime_mem.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_MEM_RUNS    (8u)
+#define BENCH_MEM_MAX     (4096u)
+#define BENCH_MEM_SLACK   (16u)    /* room for offsets and the move overlap */
+
+enum { OP_MEMCPY, OP_MEMMOVE, OP_MEMSET, OP_BYTES, BENCH_MEM_OPS };
+enum { BENCH_MEM_ALIGNS = 3, BENCH_MEM_SIZES = 6 };
+
+static const uint32_t s_size[BENCH_MEM_SIZES] = { 4u, 16u, 64u, 256u, 1024u, 4096u };
+static const uint32_t s_dst_off[BENCH_MEM_ALIGNS] = { 0u, 1u, 0u };
+static const uint32_t s_src_off[BENCH_MEM_ALIGNS] = { 0u, 1u, 1u };
+
+typedef struct {
+    uint32_t cycles[BENCH_MEM_OPS][BENCH_MEM_ALIGNS][BENCH_MEM_SIZES];    /* best call */
+    uint32_t bpc_x100[BENCH_MEM_OPS][BENCH_MEM_ALIGNS][BENCH_MEM_SIZES];  /* bytes/cycle x 100 */
+    uint32_t errors;
+} bench_mem_t;
+
+bench_mem_t g_bench_mem;
+
+static uint32_t s_src[(BENCH_MEM_MAX + BENCH_MEM_SLACK) / 4u];
+static uint32_t s_dst[(BENCH_MEM_MAX + BENCH_MEM_SLACK) / 4u];
+
+/* What the runtime replaces: one byte per iteration */
+static __attribute__((noinline)) void byte_copy(void *dst, const void *src, size_t n)
+{
+    volatile uint8_t       *d = (volatile uint8_t *)dst;
+    const volatile uint8_t *s = (const volatile uint8_t *)src;
+
+    while (n-- != 0u) {
+        *d++ = *s++;
+    }
+}
+
+static void check(const uint8_t *got, const uint8_t *want, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        if (got[i] != want[i]) {
+            g_bench_mem.errors++;
+            return;
+        }
+    }
+}
+
+/* One call of op; the buffers are reset first so memmove sees the same data */
+static uint32_t run_once(uint32_t op, uint32_t align, uint32_t n)
+{
+    uint8_t       *src = (uint8_t *)s_src + s_src_off[align];
+    uint8_t       *dst = (uint8_t *)s_dst + s_dst_off[align];
+    uint8_t       *mov = (uint8_t *)s_dst + s_src_off[align];   /* memmove source */
+    uint32_t       t0;
+    uint32_t       t1;
+
+    if (op == OP_MEMMOVE) {
+        runtime_memcpy(mov, src, n);
+    }
+
+    t0 = arch_cyccnt();
+    switch (op) {
+    case OP_MEMCPY:
+        runtime_memcpy(dst, src, n);
+        break;
+    case OP_MEMMOVE:
+        runtime_memmove(dst + 8, mov, n);
+        break;
+    case OP_MEMSET:
+        runtime_memset(dst, 0x5A, n);
+        break;
+    default:
+        byte_copy(dst, src, n);
+        break;
+    }
+    t1 = arch_cyccnt();
+
+    if (op == OP_MEMMOVE) {
+        check(dst + 8, src, n);
+    } else if (op == OP_MEMSET) {
+        for (uint32_t i = 0; i < n; i++) {
+            if (dst[i] != 0x5Au) {
+                g_bench_mem.errors++;
+                break;
+            }
+        }
+    } else {
+        check(dst, src, n);
+    }
+    return t1 - t0;
+}
+
+void bench_mem_run(void)
+{
+    for (uint32_t i = 0; i < (BENCH_MEM_MAX + BENCH_MEM_SLACK) / 4u; i++) {
+        s_src[i] = i * 0x9E3779B1u;
+    }
+
+    arch_irq_disable();
+    for (uint32_t op = 0; op < BENCH_MEM_OPS; op++) {
+        for (uint32_t a = 0; a < BENCH_MEM_ALIGNS; a++) {
+            for (uint32_t z = 0; z < BENCH_MEM_SIZES; z++) {
+                uint32_t best = UINT32_MAX;
+
+                for (uint32_t r = 0; r < BENCH_MEM_RUNS; r++) {
+                    uint32_t c = run_once(op, a, s_size[z]);
+                    if (c < best) {
+                        best = c;
+                    }
+                }
+                g_bench_mem.cycles[op][a][z]   = best;
+                g_bench_mem.bpc_x100[op][a][z] = s_size[z] * 100u / best;
+            }
+        }
+    }
+    arch_irq_enable();
+
+    bench_finish();
+}
@@ -0,0 +1,234 @@
+/* bench_pool.c — block pool cost and IRQ safety (make BENCH=pool)
+ *
+ * Cycles per operation, IRQs masked (best of BENCH_POOL_RUNS):
+ *
+ *   pair  : one alloc + one free on a warm pool
+ *   burst : alloc the whole pool, then free it all; cycles / block
+ *   empty : alloc on an exhausted pool (the NULL path)
+ *
+ * Then a stress phase: TIM2 fires every BENCH_POOL_STRESS_PERIOD cycles
+ * (prime, so it lands at every point of the thread loop, LDREX/STREX
+ * windows included) and its handler allocates and frees from the same
+ * pool the thread is cycling. Every block is stamped with its owner and
+ * checked before it is freed: a block handed out twice shows up in
+ * `corrupt`. Afterwards used must be 0 and the free list must hold
+ * exactly count blocks.
+ *
+ *   (gdb) p g_bench_pool
+ *   (gdb) p s_pool
+ */
+
+#include "bench.h"
+#include "mcu.h"
+#include "runtime_irq.h"
+#include "runtime_pool.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_POOL_BLOCK     (32u)
+#define BENCH_POOL_COUNT     (32u)
+#define BENCH_POOL_RUNS      (64u)
+
+#define BENCH_POOL_THREAD_HOLD  (4u)      /* blocks the thread holds at once */
+#define BENCH_POOL_ISR_HOLD     (2u)      /* blocks the handler holds at once */
+#define BENCH_POOL_STRESS_ITERS (20000u)
+#define BENCH_POOL_STRESS_PERIOD (397u)   /* TIM2 cycles between interrupts */
+#define BENCH_POOL_STRESS_PRIO  (1u)
+
+typedef struct {
+    uint32_t pair;              /* cycles, alloc + free */
+    uint32_t burst_alloc;       /* cycles per block, draining the pool */
+    uint32_t burst_free;        /* cycles per block, refilling it */
+    uint32_t empty;             /* cycles, alloc on an empty pool */
+    uint32_t thread_ops;        /* stress: blocks cycled by the thread */
+    uint32_t isr_ops;           /* stress: blocks cycled by the handler */
+    uint32_t isr_runs;
+    uint32_t corrupt;           /* stamp mismatches (must be 0) */
+    uint32_t bad_free;          /* runtime_pool_free() refusals (must be 0) */
+    uint32_t leaked;            /* used after the stress phase (must be 0) */
+    uint32_t free_len;          /* free list length afterwards (= count) */
+} bench_pool_t;
+
+bench_pool_t g_bench_pool;
+
+static runtime_pool_t s_pool;
+
+static uint32_t *s_held[BENCH_POOL_COUNT];
+
+/* ============================
+   Timing
+   ============================ */
+
+static void measure_cost(void)
+{
+    uint32_t best_pair  = UINT32_MAX;
+    uint32_t best_alloc = UINT32_MAX;
+    uint32_t best_free  = UINT32_MAX;
+    uint32_t best_empty = UINT32_MAX;
+
+    arch_irq_disable();
+    for (uint32_t r = 0; r < BENCH_POOL_RUNS; r++) {
+        uint32_t t0 = arch_cyccnt();
+        void    *blk = runtime_pool_alloc(&s_pool);
+        if (runtime_pool_free(&s_pool, blk) != 0) {
+            g_bench_pool.bad_free++;
+        }
+        uint32_t t1 = arch_cyccnt();
+
+        for (uint32_t i = 0; i < BENCH_POOL_COUNT; i++) {
+            s_held[i] = runtime_pool_alloc(&s_pool);
+        }
+        uint32_t t2 = arch_cyccnt();
+        (void)runtime_pool_alloc(&s_pool);
+        uint32_t t3 = arch_cyccnt();
+        for (uint32_t i = 0; i < BENCH_POOL_COUNT; i++) {
+            if (runtime_pool_free(&s_pool, s_held[i]) != 0) {
+                g_bench_pool.bad_free++;
+            }
+        }
+        uint32_t t4 = arch_cyccnt();
+
+        if ((t1 - t0) < best_pair) {
+            best_pair = t1 - t0;
+        }
+        if ((t2 - t1) < best_alloc) {
+            best_alloc = t2 - t1;
+        }
+        if ((t3 - t2) < best_empty) {
+            best_empty = t3 - t2;
+        }
+        if ((t4 - t3) < best_free) {
+            best_free = t4 - t3;
+        }
+    }
+    arch_irq_enable();
+
+    g_bench_pool.pair        = best_pair;
+    g_bench_pool.burst_alloc = best_alloc / BENCH_POOL_COUNT;
+    g_bench_pool.burst_free  = best_free / BENCH_POOL_COUNT;
+    g_bench_pool.empty       = best_empty;
+}
+
+/* ============================
+   Stress
+   ============================ */
+
+#define STAMP_ISR     (0x15000000u)
+#define STAMP_THREAD  (0x7D000000u)
+
+/* Every word of an owned block carries its owner's stamp */
+static void stamp(uint32_t *blk, uint32_t v)
+{
+    for (uint32_t i = 0; i < BENCH_POOL_BLOCK / 4u; i++) {
+        blk[i] = v;
+    }
+}
+
+static void verify(const uint32_t *blk, uint32_t v)
+{
+    for (uint32_t i = 0; i < BENCH_POOL_BLOCK / 4u; i++) {
+        if (blk[i] != v) {
+            g_bench_pool.corrupt++;
+            return;
+        }
+    }
+}
+
+static void release(uint32_t *blk)
+{
+    if (runtime_pool_free(&s_pool, blk) != 0) {
+        g_bench_pool.bad_free++;
+    }
+}
+
+static void stress_handler(void)
+{
+    uint32_t *held[BENCH_POOL_ISR_HOLD];
+    uint32_t  n = 0;
+    uint32_t  v = STAMP_ISR | g_bench_pool.isr_runs;
+
+    TIM2_SR = ~TIM_SR_UIF;
+    g_bench_pool.isr_runs++;
+
+    while (n < BENCH_POOL_ISR_HOLD) {
+        uint32_t *blk = runtime_pool_alloc(&s_pool);
+        if (blk == 0) {
+            break;
+        }
+        stamp(blk, v);
+        held[n++] = blk;
+    }
+    while (n != 0u) {
+        verify(held[--n], v);
+        release(held[n]);
+        g_bench_pool.isr_ops++;
+    }
+}
+
+static void stress_timer_start(void)
+{
+    RCC_APB1ENR1 |= RCC_APB1ENR1_TIM2EN;
+    (void)RCC_APB1ENR1;
+
+    TIM2_CR1  = 0;
+    TIM2_PSC  = 0;
+    TIM2_ARR  = BENCH_POOL_STRESS_PERIOD - 1u;
+    TIM2_EGR  = TIM_EGR_UG;
+    TIM2_SR   = 0;
+    TIM2_DIER = TIM_DIER_UIE;
+
+    runtime_irq_attach(MCU_IRQ_TIM2, stress_handler, BENCH_POOL_STRESS_PRIO);
+    TIM2_CR1  = TIM_CR1_CEN;
+}
+
+static void stress_timer_stop(void)
+{
+    TIM2_CR1  = 0;
+    TIM2_DIER = 0;
+    runtime_irq_detach(MCU_IRQ_TIM2);
+}
+
+static void stress(void)
+{
+    stress_timer_start();
+
+    for (uint32_t it = 0; it < BENCH_POOL_STRESS_ITERS; it++) {
+        uint32_t v = STAMP_THREAD | (it & 0xFFFFFFu);
+        uint32_t n = 0;
+
+        while (n < BENCH_POOL_THREAD_HOLD) {
+            uint32_t *blk = runtime_pool_alloc(&s_pool);
+            if (blk == 0) {
+                break;
+            }
+            stamp(blk, v);
+            s_held[n++] = blk;
+        }
+        while (n != 0u) {
+            verify(s_held[--n], v);
+            release(s_held[n]);
+            g_bench_pool.thread_ops++;
+        }
+    }
+
+    stress_timer_stop();
+
+    /* Walk the free list (bounded, in case it was broken into a cycle) */
+    const void *blk = s_pool.free;
+    while ((blk != 0) && (g_bench_pool.free_len <= s_pool.count)) {
+        g_bench_pool.free_len++;
+        blk = *(void *const *)blk;
+    }
+    g_bench_pool.leaked = s_pool.used;
+}
+
+void bench_pool_run(void)
+{
+    if (runtime_pool_init(&s_pool, "bench", BENCH_POOL_BLOCK, BENCH_POOL_COUNT) != 0) {
+        bench_finish();
+    }
+
+    measure_cost();
+    stress();
+
+    bench_finish();
+}
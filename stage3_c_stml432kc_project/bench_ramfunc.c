@@ -0,0 +1,130 @@
+/* bench_ramfunc.c — flash vs SRAM2 execution (make BENCH=ramfunc)
+ *
+ * The same compute loop is built twice, once in .text (flash) and once
+ * in .ramfunc (SRAM2), and timed under three fetch conditions:
+ *
+ *   4 MHz          : 0 wait states, flash is as fast as RAM
+ *   80 MHz         : 4 wait states, hidden by prefetch + ART cache
+ *   80 MHz no ART  : 4 wait states exposed on every fetch
+ *
+ * The tick handler is timed by pending SysTick from thread mode (entry,
+ * handler body, exit). Its placement is fixed per build, so compare
+ * `make BENCH=ramfunc` with `make BENCH=ramfunc TICK_RAMFUNC=0`.
+ * Each forced tick credits 1 ms, so millis runs ahead in this build.
+ *
+ *   (gdb) p g_bench_ramfunc
+ */
+
+#include "bench.h"
+#include "board.h"
+#include "mcu.h"
+#include "runtime_section.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_RAMFUNC_RUNS    (3u)
+#define BENCH_RAMFUNC_ITERS   (64u)
+#define BENCH_RAMFUNC_TICKS   (256u)
+#define BENCH_RAMFUNC_WORDS   (64u)
+
+typedef struct {
+    uint32_t     hz[BENCH_RAMFUNC_RUNS];
+    uint32_t     art[BENCH_RAMFUNC_RUNS];   /* prefetch + caches on */
+    bench_stat_t loop_flash[BENCH_RAMFUNC_RUNS];
+    bench_stat_t loop_ram[BENCH_RAMFUNC_RUNS];
+    bench_stat_t tick[BENCH_RAMFUNC_RUNS];  /* pend -> return, cycles */
+    uint32_t     tick_in_ram;
+    uint32_t     errors;                    /* flash/RAM results differ */
+} bench_ramfunc_t;
+
+bench_ramfunc_t g_bench_ramfunc;
+
+/* Operands in SRAM1, so only instruction fetch differs between the two */
+static uint32_t s_data[BENCH_RAMFUNC_WORDS];
+
+/* One body, two placements */
+#define LOOP_BODY                                                         \
+    uint32_t acc = seed;                                                  \
+    for (uint32_t i = 0; i < BENCH_RAMFUNC_WORDS; i++) {                  \
+        uint32_t v = s_data[i] ^ acc;                                     \
+        acc = (acc << 5) + (acc >> 3) + v * 0x9E3779B1u;                  \
+        if (v & 1u) {                                                     \
+            acc ^= 0x5BD1E995u;                                           \
+        }                                                                 \
+    }                                                                     \
+    return acc
+
+static __attribute__((noinline)) uint32_t loop_flash(uint32_t seed)
+{
+    LOOP_BODY;
+}
+
+RUNTIME_RAMFUNC static uint32_t loop_ram(uint32_t seed)
+{
+    LOOP_BODY;
+}
+
+static void measure_loops(uint32_t run)
+{
+    arch_irq_disable();
+    for (uint32_t n = 0; n < BENCH_RAMFUNC_ITERS; n++) {
+        uint32_t t0 = arch_cyccnt();
+        uint32_t a  = loop_flash(n);
+        uint32_t t1 = arch_cyccnt();
+        uint32_t b  = loop_ram(n);
+        uint32_t t2 = arch_cyccnt();
+
+        bench_stat_add(&g_bench_ramfunc.loop_flash[run], t1 - t0);
+        bench_stat_add(&g_bench_ramfunc.loop_ram[run], t2 - t1);
+        if (a != b) {
+            g_bench_ramfunc.errors++;
+        }
+    }
+    arch_irq_enable();
+}
+
+static void measure_tick(uint32_t run)
+{
+    for (uint32_t n = 0; n < BENCH_RAMFUNC_TICKS; n++) {
+        uint32_t t0 = arch_cyccnt();
+        SCB_ICSR = SCB_ICSR_PENDSTSET;
+        __asm__ volatile ("dsb\n isb" ::: "memory");
+        bench_stat_add(&g_bench_ramfunc.tick[run], arch_cyccnt() - t0);
+    }
+}
+
+static void measure(uint32_t run, uint32_t profile, uint32_t art)
+{
+    board_set_clock_profile(profile);
+    if (!art) {
+        FLASH_ACR &= ~(FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN);
+    }
+
+    g_bench_ramfunc.hz[run]  = init_clock_profile_hz(profile);
+    g_bench_ramfunc.art[run] = art;
+    bench_stat_reset(&g_bench_ramfunc.loop_flash[run]);
+    bench_stat_reset(&g_bench_ramfunc.loop_ram[run]);
+    bench_stat_reset(&g_bench_ramfunc.tick[run]);
+
+    measure_loops(run);
+    measure_tick(run);
+}
+
+void bench_ramfunc_run(void)
+{
+    for (uint32_t i = 0; i < BENCH_RAMFUNC_WORDS; i++) {
+        s_data[i] = i * 0x01000193u + 7u;
+    }
+
+#ifdef RUNTIME_TICK_RAMFUNC
+    g_bench_ramfunc.tick_in_ram = 1u;
+#endif
+
+    measure(0u, CLOCK_PROFILE_MSI_4MHZ,  1u);
+    measure(1u, CLOCK_PROFILE_PLL_80MHZ, 1u);
+    measure(2u, CLOCK_PROFILE_PLL_80MHZ, 0u);
+
+    /* Boot profile again; also restores the accelerator bits */
+    board_set_clock_profile(CLOCK_PROFILE);
+
+    bench_finish();
+}
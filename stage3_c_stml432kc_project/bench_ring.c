@@ -0,0 +1,107 @@
+/* bench_ring.c — SPSC ring throughput (make BENCH=ring)
+ *
+ * Pushes a running sequence through a 64-slot ring of uint32_t and checks
+ * it on the way out, in two shapes:
+ *
+ *   single : push() + pop() per element
+ *   batch  : reserve/commit spans in, pop_batch() out
+ *
+ * Both sides run in thread context, so the numbers are the pure API cost.
+ * Cycle stats are per element; ops_per_sec = SYSCLK_HZ / mean.
+ */
+
+#include "bench.h"
+#include "board.h"
+#include "runtime_ring.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_RING_ELEMS   (4096u)
+#define BENCH_RING_BATCH   (16u)
+
+typedef struct {
+    bench_stat_t single;       /* cycles per element, push + pop */
+    bench_stat_t batch;        /* cycles per element, span in + batch out */
+    uint32_t     single_ops_per_sec;
+    uint32_t     batch_ops_per_sec;
+    uint32_t     errors;       /* sequence mismatches (must be 0) */
+} bench_ring_t;
+
+bench_ring_t g_bench_ring;
+
+RUNTIME_RING_STORAGE(s_storage, uint32_t, 64u);
+static runtime_ring_t s_ring;
+
+static uint32_t ops_per_sec(const bench_stat_t *s)
+{
+    uint32_t mean = (uint32_t)(s->sum / s->count);
+    return (mean != 0u) ? (SYSCLK_HZ / mean) : 0u;
+}
+
+static void bench_single(void)
+{
+    uint32_t expect = 0;
+
+    for (uint32_t i = 0; i < BENCH_RING_ELEMS; i++) {
+        uint32_t out;
+        uint32_t t0 = arch_cyccnt();
+        runtime_ring_push(&s_ring, &i);
+        runtime_ring_pop(&s_ring, &out);
+        bench_stat_add(&g_bench_ring.single, arch_cyccnt() - t0);
+
+        if (out != expect++) {
+            g_bench_ring.errors++;
+        }
+    }
+}
+
+static void bench_batch(void)
+{
+    uint32_t seq    = 0;
+    uint32_t expect = 0;
+    uint32_t out[BENCH_RING_BATCH];
+
+    while (seq < BENCH_RING_ELEMS) {
+        uint32_t t0 = arch_cyccnt();
+
+        /* Fill up to one batch, in at most two spans */
+        uint32_t filled = 0;
+        while (filled < BENCH_RING_BATCH) {
+            uint32_t  granted;
+            uint32_t *span = runtime_ring_reserve(&s_ring, BENCH_RING_BATCH - filled, &granted);
+            if (granted == 0u) {
+                break;
+            }
+            for (uint32_t k = 0; k < granted; k++) {
+                span[k] = seq++;
+            }
+            runtime_ring_commit(&s_ring, granted);
+            filled += granted;
+        }
+
+        uint32_t n = runtime_ring_pop_batch(&s_ring, out, BENCH_RING_BATCH);
+        uint32_t dt = arch_cyccnt() - t0;
+
+        for (uint32_t k = 0; k < n; k++) {
+            bench_stat_add(&g_bench_ring.batch, dt / n);
+            if (out[k] != expect++) {
+                g_bench_ring.errors++;
+            }
+        }
+    }
+}
+
+void bench_ring_run(void)
+{
+    bench_stat_reset(&g_bench_ring.single);
+    bench_stat_reset(&g_bench_ring.batch);
+    g_bench_ring.errors = 0;
+
+    runtime_ring_init(&s_ring, s_storage, sizeof(s_storage[0]), 64u);
+    bench_single();
+    bench_batch();
+
+    g_bench_ring.single_ops_per_sec = ops_per_sec(&g_bench_ring.single);
+    g_bench_ring.batch_ops_per_sec  = ops_per_sec(&g_bench_ring.batch);
+
+    bench_finish();
+}
@@ -0,0 +1,60 @@
+/* bench_sched.c — context-switch latency (make BENCH=sched)
+ *
+ * A low-priority task wakes a blocked high-priority task and the high task
+ * timestamps its first instruction after the switch:
+ *
+ *   switch_in  : wake() call -> PendSV -> first cycle in the high task
+ *   round_trip : wake() call -> high task runs and blocks -> back in low
+ *
+ * Read g_bench_sched from the debugger once g_bench_done is set.
+ */
+
+#include "bench.h"
+#include "runtime_sched.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_SCHED_ITERATIONS  (1000u)
+
+typedef struct {
+    bench_stat_t switch_in;
+    bench_stat_t round_trip;
+} bench_sched_t;
+
+bench_sched_t g_bench_sched;
+
+static runtime_task_t s_hi;
+static runtime_task_t s_lo;
+RUNTIME_TASK_STACK(s_hi_stack, 512u);
+RUNTIME_TASK_STACK(s_lo_stack, 512u);
+
+static volatile uint32_t s_t0;
+
+static void hi_entry(void *arg)
+{
+    for (;;) {
+        runtime_sched_block();
+        bench_stat_add(&g_bench_sched.switch_in, arch_cyccnt() - s_t0);
+    }
+}
+
+static void lo_entry(void *arg)
+{
+    for (uint32_t i = 0; i < BENCH_SCHED_ITERATIONS; i++) {
+        s_t0 = arch_cyccnt();
+        runtime_sched_wake(&s_hi);
+        bench_stat_add(&g_bench_sched.round_trip, arch_cyccnt() - s_t0);
+    }
+
+    bench_finish();
+}
+
+void bench_sched_run(void)
+{
+    bench_stat_reset(&g_bench_sched.switch_in);
+    bench_stat_reset(&g_bench_sched.round_trip);
+
+    runtime_sched_add(&s_hi, hi_entry, 0, s_hi_stack, sizeof(s_hi_stack), 1u);
+    runtime_sched_add(&s_lo, lo_entry, 0, s_lo_stack, sizeof(s_lo_stack), 2u);
+
+    runtime_sched_start();
+}
@@ -0,0 +1,113 @@
+/* bench_startup.c — Reset_Handler region init: burst vs word loop
+ * (make BENCH=startup)
+ *
+ * Runs the original one-word-per-iteration .data/.bss loops and the
+ * table-driven burst routines from startup.s over the same buffers, for a
+ * range of region sizes. Results are cycles per region size:
+ *
+ *   (gdb) p g_bench_startup
+ */
+
+#include "bench.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_STARTUP_MAX_BYTES  (4096u)
+#define BENCH_STARTUP_SIZES      (6u)
+
+/* startup.s */
+void startup_region_copy(const void *src, void *dst, uint32_t bytes);
+void startup_region_zero(void *dst, uint32_t bytes);
+
+typedef struct {
+    uint32_t bytes[BENCH_STARTUP_SIZES];
+    uint32_t copy_word[BENCH_STARTUP_SIZES];   /* legacy .data loop */
+    uint32_t copy_burst[BENCH_STARTUP_SIZES];  /* startup_region_copy */
+    uint32_t zero_word[BENCH_STARTUP_SIZES];   /* legacy .bss loop */
+    uint32_t zero_burst[BENCH_STARTUP_SIZES];  /* startup_region_zero */
+    uint32_t errors;
+} bench_startup_t;
+
+bench_startup_t g_bench_startup;
+
+static const uint32_t s_sizes[BENCH_STARTUP_SIZES] = { 16u, 64u, 256u, 1024u, 2048u, 4096u };
+
+/* Flash-resident source, like .data's load image */
+static const uint32_t s_src[BENCH_STARTUP_MAX_BYTES / 4u] = { 0x5A5A5A5Au, 1u, 2u, 3u };
+static uint32_t       s_dst[BENCH_STARTUP_MAX_BYTES / 4u];
+
+/* The pre-table Reset_Handler loops, verbatim */
+static void legacy_copy(const uint32_t *src, uint32_t *dst, uint32_t *end)
+{
+    __asm__ volatile (
+        "1:  cmp  %1, %2        \n"
+        "    bcc  2f            \n"
+        "    b    3f            \n"
+        "2:  ldr  r3, [%0], #4  \n"
+        "    str  r3, [%1], #4  \n"
+        "    b    1b            \n"
+        "3:                     \n"
+        : "+r" (src), "+r" (dst)
+        : "r" (end)
+        : "r3", "cc", "memory");
+}
+
+static void legacy_zero(uint32_t *dst, uint32_t *end)
+{
+    __asm__ volatile (
+        "1:  cmp  %0, %1        \n"
+        "    bcc  2f            \n"
+        "    b    3f            \n"
+        "2:  movs r2, #0        \n"
+        "    str  r2, [%0], #4  \n"
+        "    b    1b            \n"
+        "3:                     \n"
+        : "+r" (dst)
+        : "r" (end)
+        : "r2", "cc", "memory");
+}
+
+static void check(uint32_t words, uint32_t zero)
+{
+    for (uint32_t i = 0; i < words; i++) {
+        if (s_dst[i] != (zero ? 0u : s_src[i])) {
+            g_bench_startup.errors++;
+        }
+    }
+}
+
+void bench_startup_run(void)
+{
+    for (uint32_t n = 0; n < BENCH_STARTUP_SIZES; n++) {
+        uint32_t bytes = s_sizes[n];
+        uint32_t words = bytes / 4u;
+        uint32_t t0;
+
+        g_bench_startup.bytes[n] = bytes;
+
+        arch_irq_disable();
+
+        t0 = arch_cyccnt();
+        legacy_copy(s_src, s_dst, s_dst + words);
+        g_bench_startup.copy_word[n] = arch_cyccnt() - t0;
+        check(words, 0u);
+
+        t0 = arch_cyccnt();
+        legacy_zero(s_dst, s_dst + words);
+        g_bench_startup.zero_word[n] = arch_cyccnt() - t0;
+        check(words, 1u);
+
+        t0 = arch_cyccnt();
+        startup_region_copy(s_src, s_dst, bytes);
+        g_bench_startup.copy_burst[n] = arch_cyccnt() - t0;
+        check(words, 0u);
+
+        t0 = arch_cyccnt();
+        startup_region_zero(s_dst, bytes);
+        g_bench_startup.zero_burst[n] = arch_cyccnt() - t0;
+        check(words, 1u);
+
+        arch_irq_enable();
+    }
+
+    bench_finish();
+}
@@ -6,10 +6,54 @@
 #include "board.h"
 #include "init_clock.h"
 #include "init_board.h"
+#include "runtime.h"
+#include "runtime_prof.h"
+#include "runtime_trace.h"
+#include "runtime_pcprof.h"
+#include "runtime_irq.h"
 
 void board_init(void)
 {
+    RUNTIME_TRACE_BEGIN("board_init");
+
+    RUNTIME_TRACE_BEGIN("init_clock");
+    RUNTIME_PROF_BEGIN(init_clock);
     init_clock();
+    RUNTIME_PROF_END(init_clock);
+    RUNTIME_TRACE_CLOCK(SYSCLK_HZ);
+    RUNTIME_TRACE_END("init_clock");
+
+    RUNTIME_TRACE_BEGIN("init_board");
+    RUNTIME_PROF_BEGIN(init_board);
     init_board();
+    RUNTIME_PROF_END(init_board);
+    RUNTIME_TRACE_END("init_board");
+
+    RUNTIME_TRACE_END("board_init");
 }
 
+
+void board_set_clock_profile(uint32_t profile)
+{
+    uint32_t hz = init_clock_profile_hz(profile);
+
+    if (hz != 0u) {
+        runtime_set_sysclk(hz, init_clock_profile, profile);
+    }
+}
+
+#ifdef RUNTIME_PCPROF
+void board_pcprof_start(uint32_t hz)
+{
+    runtime_pcprof_init();
+
+#if RUNTIME_PCPROF == RUNTIME_PCPROF_SRC_TIMER
+    /* Most urgent level: samples land inside other handlers too */
+    runtime_pcprof_start_timer(init_pcprof_timer_ack);
+    init_pcprof_timer(hz, SYSCLK_HZ);
+    runtime_irq_attach(MCU_IRQ_TIM7, runtime_pcprof_timer_entry, 0u);
+#else
+    runtime_pcprof_start_systick();
+#endif
+}
+#endif /* RUNTIME_PCPROF */
@@ -15,5 +15,18 @@
  */
 void board_init(void);
 
+/* Switch clock profile at run time (CLOCK_PROFILE_* from init_clock.h).
+ * The runtime timebase follows the new SYSCLK without a jump.
+ * Requires runtime_init().
+ */
+void board_set_clock_profile(uint32_t profile);
+
+/* Start the PC-sampling profiler (runtime_pcprof.h) on the source chosen
+ * with make PCPROF=systick | timer. hz applies to the timer source, which
+ * is programmed for the boot clock (SYSCLK_HZ). Requires runtime_init().
+ * Only built with PCPROF set.
+ */
+void board_pcprof_start(uint32_t hz);
+
 #endif /* BOARD_H */
 
@@ -67,3 +67,26 @@ void board_led_toggle(void)
     GPIOB_ODR ^= (1u << PB3_PIN);
 }
 
+
+void init_pcprof_timer(uint32_t hz, uint32_t clk_hz)
+{
+    /* TIM7 runs from PCLK1 (= SYSCLK, APB1 undivided); 16-bit PSC and ARR */
+    uint32_t div = clk_hz / hz;
+    uint32_t psc = (div - 1u) / 65536u;
+
+    RCC_APB1ENR1 |= RCC_APB1ENR1_TIM7EN;
+    (void)RCC_APB1ENR1;
+
+    TIM7_CR1  = 0;
+    TIM7_PSC  = psc;
+    TIM7_ARR  = (div / (psc + 1u)) - 1u;
+    TIM7_EGR  = TIM_EGR_UG;     /* load PSC now */
+    TIM7_SR   = 0;
+    TIM7_DIER = TIM_DIER_UIE;
+    TIM7_CR1  = TIM_CR1_CEN;
+}
+
+void init_pcprof_timer_ack(void)
+{
+    TIM7_SR = ~TIM_SR_UIF;
+}
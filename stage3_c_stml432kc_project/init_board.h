@@ -16,5 +16,11 @@ void board_led_on(void);
 void board_led_off(void);
 void board_led_toggle(void);
 
+/* PC-sampling timer (TIM7): update interrupt at hz from a clk_hz kernel
+ * clock, and the acknowledge its handler must call.
+ */
+void init_pcprof_timer(uint32_t hz, uint32_t clk_hz);
+void init_pcprof_timer_ack(void);
+
 #endif /* INIT_BOARD_H */
 
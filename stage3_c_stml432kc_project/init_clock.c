@@ -6,29 +6,134 @@
 
 #include <stdint.h>
 #include "mcu.h"
+#include "init_clock.h"
 
 /* -----------------------------
-   Public API
+   Profile table
 ----------------------------- */
-void init_clock(void)
+typedef struct {
+    uint32_t hz;
+    uint32_t msi_range;   /* RCC_CR MSIRANGE: SYSCLK, or PLL input */
+    uint32_t pllcfgr;     /* 0 = SYSCLK straight from MSI */
+    uint32_t vos;         /* PWR_CR1 VOS: 1 or 2 */
+    uint32_t latency;     /* FLASH_ACR wait states */
+} clock_profile_desc_t;
+
+/* PLL: MSI 4 MHz / M=1 * N=40 = VCO 160 MHz, / R=2 = 80 MHz */
+#define PLLCFGR_80MHZ  (RCC_PLLCFGR_PLLSRC_MSI           | \
+                        (0u  << RCC_PLLCFGR_PLLM_SHIFT)  | \
+                        (40u << RCC_PLLCFGR_PLLN_SHIFT)  | \
+                        (0u  << RCC_PLLCFGR_PLLR_SHIFT)  | \
+                        RCC_PLLCFGR_PLLREN)
+
+static const clock_profile_desc_t s_profiles[CLOCK_PROFILE_COUNT] = {
+    [CLOCK_PROFILE_MSI_4MHZ]  = {  4000000u, RCC_MSIRANGE_4MHZ,  0u,            2u, 0u },
+    [CLOCK_PROFILE_MSI_16MHZ] = { 16000000u, RCC_MSIRANGE_16MHZ, 0u,            1u, 0u },
+    [CLOCK_PROFILE_PLL_80MHZ] = { 80000000u, RCC_MSIRANGE_4MHZ,  PLLCFGR_80MHZ, 1u, 4u },
+};
+
+/* -----------------------------
+   Helpers
+----------------------------- */
+static uint32_t vos_get(void)
 {
-    /* Ensure MSI on */
-    RCC_CR |= RCC_CR_MSION;
-    while ((RCC_CR & RCC_CR_MSIRDY) == 0u) { }
+    return (PWR_CR1 & PWR_CR1_VOS_MASK) >> PWR_CR1_VOS_SHIFT;
+}
 
-    /* Set MSI range to 4 MHz */
-    RCC_ICSCR =
-        (RCC_ICSCR & ~RCC_ICSCR_MSIRANGE_MASK) |
-         RCC_ICSCR_MSIRANGE_4MHZ;
+static void vos_set(uint32_t vos)
+{
+    PWR_CR1 = (PWR_CR1 & ~PWR_CR1_VOS_MASK) | (vos << PWR_CR1_VOS_SHIFT);
+    while (PWR_SR2 & PWR_SR2_VOSF) { }
+}
 
-    /* Force SYSCLK source to MSI */
+static void flash_latency_set(uint32_t latency)
+{
+    uint32_t acr = FLASH_ACR & ~(FLASH_ACR_LATENCY_MASK | FLASH_ACR_PRFTEN);
+
+    acr |= latency | FLASH_ACR_ICEN | FLASH_ACR_DCEN;
+    if (latency != 0u) {
+        /* Prefetch only pays for itself when there are wait states */
+        acr |= FLASH_ACR_PRFTEN;
+    }
+    FLASH_ACR = acr;
+
+    /* New latency must be in effect before the clock changes */
+    while ((FLASH_ACR & FLASH_ACR_LATENCY_MASK) != latency) { }
+}
+
+static void sysclk_to_msi(void)
+{
     RCC_CFGR &= ~RCC_CFGR_SW_MASK;
     while ((RCC_CFGR & RCC_CFGR_SWS_MASK) != 0u) { }
+}
 
-    /* Disable PLL for determinism */
+static void pll_off(void)
+{
     if (RCC_CR & RCC_CR_PLLON) {
         RCC_CR &= ~RCC_CR_PLLON;
         while (RCC_CR & RCC_CR_PLLRDY) { }
     }
 }
 
+/* -----------------------------
+   Public API
+----------------------------- */
+uint32_t init_clock_profile_hz(uint32_t profile)
+{
+    return (profile < CLOCK_PROFILE_COUNT) ? s_profiles[profile].hz : 0u;
+}
+
+void init_clock_profile(uint32_t profile)
+{
+    if (profile >= CLOCK_PROFILE_COUNT) {
+        return;
+    }
+
+    const clock_profile_desc_t *p = &s_profiles[profile];
+
+    RCC_APB1ENR1 |= RCC_APB1ENR1_PWREN;
+
+    /* Going up: voltage and wait states first */
+    if (p->vos < vos_get()) {
+        vos_set(p->vos);
+    }
+    if (p->latency > (FLASH_ACR & FLASH_ACR_LATENCY_MASK)) {
+        flash_latency_set(p->latency);
+    }
+
+    /* Ensure MSI on */
+    RCC_CR |= RCC_CR_MSION;
+    while ((RCC_CR & RCC_CR_MSIRDY) == 0u) { }
+
+    /* Park SYSCLK on MSI while the PLL and MSI range change */
+    sysclk_to_msi();
+    pll_off();
+
+    /* MSI range (only writable while MSI is ready) */
+    RCC_CR = (RCC_CR & ~RCC_CR_MSIRANGE_MASK) |
+             (p->msi_range << RCC_CR_MSIRANGE_SHIFT) |
+             RCC_CR_MSIRGSEL;
+    while ((RCC_CR & RCC_CR_MSIRDY) == 0u) { }
+
+    if (p->pllcfgr != 0u) {
+        RCC_PLLCFGR = p->pllcfgr;
+        RCC_CR |= RCC_CR_PLLON;
+        while ((RCC_CR & RCC_CR_PLLRDY) == 0u) { }
+
+        RCC_CFGR = (RCC_CFGR & ~RCC_CFGR_SW_MASK) | RCC_CFGR_SW_PLL;
+        while ((RCC_CFGR & RCC_CFGR_SWS_MASK) != RCC_CFGR_SWS_PLL) { }
+    }
+
+    /* Going down: wait states and voltage last */
+    if (p->latency != (FLASH_ACR & FLASH_ACR_LATENCY_MASK)) {
+        flash_latency_set(p->latency);
+    }
+    if (p->vos > vos_get()) {
+        vos_set(p->vos);
+    }
+}
+
+void init_clock(void)
+{
+    init_clock_profile(CLOCK_PROFILE);
+}
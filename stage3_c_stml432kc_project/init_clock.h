@@ -3,15 +3,47 @@
 
 #include <stdint.h>
 
+/* Clock profiles.
+ * Each one fixes SYSCLK, the core voltage range and the flash wait states.
+ *
+ *   MSI_4MHZ  : MSI 4 MHz, range 2, 0 WS           (Stage3 default)
+ *   MSI_16MHZ : MSI 16 MHz, range 1, 0 WS
+ *   PLL_80MHZ : MSI 4 MHz -> PLL 80 MHz, range 1, 4 WS, prefetch on
+ *
+ * Instruction/data caches (ART) stay on in every profile.
+ */
+#define CLOCK_PROFILE_MSI_4MHZ   0u
+#define CLOCK_PROFILE_MSI_16MHZ  1u
+#define CLOCK_PROFILE_PLL_80MHZ  2u
+#define CLOCK_PROFILE_COUNT      3u
+
+/* Boot profile, chosen at build time: make CLOCK_PROFILE=PLL_80MHZ */
+#ifndef CLOCK_PROFILE
+#define CLOCK_PROFILE CLOCK_PROFILE_MSI_4MHZ
+#endif
+
 /* Stage3 clock contract:
- * SYSCLK is MSI @ 4 MHz.
+ * SYSCLK_HZ follows the boot profile, so runtime_init(SYSCLK_HZ) stays right.
  */
+#if CLOCK_PROFILE == CLOCK_PROFILE_PLL_80MHZ
+#define SYSCLK_HZ 80000000u
+#elif CLOCK_PROFILE == CLOCK_PROFILE_MSI_16MHZ
+#define SYSCLK_HZ 16000000u
+#else
 #define SYSCLK_HZ 4000000u
+#endif
 
-/* Initialize system clock.
+/* Initialize system clock to the boot profile.
  * Must be called before runtime_init().
  */
 void init_clock(void);
 
-#endif /* INIT_CLOCK_H */
+/* Switch to another profile. Orders voltage range, flash latency and the
+ * clock switch so every intermediate state is within spec.
+ */
+void init_clock_profile(uint32_t profile);
+
+/* SYSCLK of a profile in Hz (0 if unknown) */
+uint32_t init_clock_profile_hz(uint32_t profile);
 
+#endif /* INIT_CLOCK_H */
@@ -3,20 +3,74 @@
 ------------------------------------ */
 #include <stdint.h>
 #include "runtime.h"
+#include "runtime_timer.h"
+#include "runtime_event.h"
+#include "runtime_prof.h"
+#include "runtime_log.h"
+#include "runtime_rtt.h"
 #include "board.h"
+#ifdef BENCH
+#include "bench.h"
+#endif
+
+/* Application events (runtime_event.h) */
+enum {
+    APP_EVENT_BLINK,
+};
+
+static runtime_timer_t s_blink_timer;
+
+/* SysTick context: only post; the work runs in the main loop */
+static void blink_tick(runtime_timer_t *timer, void *arg)
+{
+    (void)runtime_event_post(1u, APP_EVENT_BLINK, 0u);
+}
+
+static void on_blink(const runtime_event_t *ev)
+{
+    board_led_toggle();
+}
 
 int main(void)
 {
     /* EARLY MAIN SIGNATURE: prove we reached main() */
+    RUNTIME_PROF_BEGIN(board_early_signature);
     board_early_signature();
+    RUNTIME_PROF_END(board_early_signature);
+
+    /* Before anything that may log (decode: tools/log_decode.py) */
+    runtime_log_init();
+    runtime_rtt_init();
+    runtime_event_init();
+
+    /* Boot-phase cycle costs land in g_prof[] (see runtime_prof.h) */
+    runtime_prof_boot_phases();
 
     runtime_irq_disable();
 
+    RUNTIME_PROF_BEGIN(board_init);
     board_init();
+    RUNTIME_PROF_END(board_init);
 
+    RUNTIME_PROF_BEGIN(runtime_init);
     runtime_init(SYSCLK_HZ);
+    RUNTIME_PROF_END(runtime_init);
+
     runtime_irq_enable();
 
+    RUNTIME_LOG("runtime up, sysclk %u Hz", SYSCLK_HZ);
+    runtime_rtt_puts("blink: up\n");
+
+#ifdef RUNTIME_PCPROF
+    /* Flat profile into g_pcprof (tools/pcprof_report.py) */
+    board_pcprof_start(RUNTIME_PCPROF_HZ);
+#endif
+
+#ifdef BENCH
+    /* Benchmark build: hand over; results land in g_bench_* (see README) */
+    BENCH_ENTRY();
+#endif
+
     /* guard window: prove SysTick and IRQs are alive */
     board_led_on();
     runtime_delay_ms(150u);
@@ -29,9 +83,17 @@ int main(void)
     board_led_off();
     runtime_delay_ms(250u);
 
+    runtime_event_register(APP_EVENT_BLINK, on_blink);
+    runtime_timer_init(&s_blink_timer, blink_tick, 0);
+    runtime_timer_start(&s_blink_timer, 1u, 500u);
+
+    /* Event loop: handlers run here, never in interrupt context */
     while (1) {
-        board_led_toggle();
-        runtime_delay_ms(500u);
+        runtime_event_dispatch(RUNTIME_EVENT_BATCH);
+
+        /* Log records out through RTT channel 1 (tools/rtt_read.py) */
+        runtime_rtt_pump_log();
+        runtime_event_wait();
     }
 }
 
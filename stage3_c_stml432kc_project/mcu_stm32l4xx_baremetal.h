@@ -13,27 +13,66 @@
 #define RCC_CR             REG32(RCC_BASE + 0x00u)
 #define RCC_ICSCR          REG32(RCC_BASE + 0x04u)
 #define RCC_CFGR           REG32(RCC_BASE + 0x08u)
+#define RCC_PLLCFGR        REG32(RCC_BASE + 0x0Cu)
 #define RCC_AHB2ENR        REG32(RCC_BASE + 0x4Cu)
+#define RCC_APB1ENR1       REG32(RCC_BASE + 0x58u)
 #define RCC_APB2ENR        REG32(RCC_BASE + 0x60u)
 
 /* RCC bits */
 #define RCC_CR_MSION       (1u << 0)
 #define RCC_CR_MSIRDY      (1u << 1)
+#define RCC_CR_MSIRGSEL    (1u << 3)   /* MSI range from CR, not CSR */
 #define RCC_CR_PLLON       (1u << 24)
 #define RCC_CR_PLLRDY      (1u << 25)
 
-/* CFGR SW[1:0] system clock switch: 00 = MSI */
+/* CR MSIRANGE[7:4]: 6 = 4 MHz, 8 = 16 MHz, 11 = 48 MHz */
+#define RCC_CR_MSIRANGE_SHIFT (4u)
+#define RCC_CR_MSIRANGE_MASK  (0xFu << RCC_CR_MSIRANGE_SHIFT)
+#define RCC_MSIRANGE_4MHZ     (6u)
+#define RCC_MSIRANGE_16MHZ    (8u)
+
+/* CFGR SW[1:0] system clock switch: 00 = MSI, 11 = PLL */
 #define RCC_CFGR_SW_MASK   (3u << 0)
+#define RCC_CFGR_SW_PLL    (3u << 0)
 #define RCC_CFGR_SWS_MASK  (3u << 2)
+#define RCC_CFGR_SWS_PLL   (3u << 2)
 
-/* ICSCR MSI range: MSIRANGE[7:4], Range 6 = 4 MHz */
-#define RCC_ICSCR_MSIRANGE_SHIFT (4u)
-#define RCC_ICSCR_MSIRANGE_MASK  (0xFu << RCC_ICSCR_MSIRANGE_SHIFT)
-#define RCC_ICSCR_MSIRANGE_4MHZ  (6u << RCC_ICSCR_MSIRANGE_SHIFT)
+/* PLLCFGR: f(R) = f(src) / M * N / R */
+#define RCC_PLLCFGR_PLLSRC_MSI  (1u << 0)
+#define RCC_PLLCFGR_PLLM_SHIFT  (4u)     /* M = PLLM + 1 */
+#define RCC_PLLCFGR_PLLN_SHIFT  (8u)     /* N = PLLN (8..86) */
+#define RCC_PLLCFGR_PLLREN      (1u << 24)
+#define RCC_PLLCFGR_PLLR_SHIFT  (25u)    /* R = 2 * (PLLR + 1) */
 
 /* Peripheral clock enables used by this project */
 #define RCC_AHB2ENR_GPIOBEN (1u << 1)
 #define RCC_APB2ENR_SYSCFGEN (1u << 0)
+#define RCC_APB1ENR1_PWREN  (1u << 28)
+#define RCC_APB1ENR1_TIM7EN (1u << 5)
+#define RCC_APB1ENR1_TIM2EN (1u << 0)
+
+/* ============================
+   PWR (STM32L4xx)
+   ============================ */
+#define PWR_BASE           (0x40007000u)
+#define PWR_CR1            REG32(PWR_BASE + 0x00u)
+#define PWR_SR2            REG32(PWR_BASE + 0x14u)
+
+/* CR1 VOS[10:9]: 01 = range 1 (up to 80 MHz), 10 = range 2 (up to 26 MHz) */
+#define PWR_CR1_VOS_SHIFT  (9u)
+#define PWR_CR1_VOS_MASK   (3u << PWR_CR1_VOS_SHIFT)
+#define PWR_SR2_VOSF       (1u << 10)
+
+/* ============================
+   FLASH (STM32L4xx)
+   ============================ */
+#define FLASH_BASE         (0x40022000u)
+#define FLASH_ACR          REG32(FLASH_BASE + 0x00u)
+
+#define FLASH_ACR_LATENCY_MASK (7u << 0)
+#define FLASH_ACR_PRFTEN   (1u << 8)
+#define FLASH_ACR_ICEN     (1u << 9)
+#define FLASH_ACR_DCEN     (1u << 10)
 
 /* ============================
    GPIOB (STM32L4xx)
@@ -50,5 +89,61 @@
 #define SYSCFG_CFGR1       REG32(SYSCFG_BASE + 0x00u)
 #define SYSCFG_CFGR1_TRACESWO_DISABLE (1u << 24)
 
+/* ============================
+   SRAM2 (STM32L43x)
+   ============================ */
+/* 16 KiB, mapped twice: code-bus alias (linker.ld SRAM2 region) and right
+ * after SRAM1 on the system bus. Bus masters other than the core (DMA)
+ * use the system-bus alias.
+ */
+#define MCU_SRAM2_CODE_BASE  (0x10000000u)
+#define MCU_SRAM2_SBUS_BASE  (0x2000C000u)
+#define MCU_SRAM2_SIZE       (0x4000u)
+
+#define MCU_SRAM2_TO_SBUS(addr) \
+    ((uint32_t)(addr) - MCU_SRAM2_CODE_BASE + MCU_SRAM2_SBUS_BASE)
+
+/* ============================
+   TIM2 32-bit timer (STM32L4xx)
+   ============================ */
+#define TIM2_BASE          (0x40000000u)
+#define TIM2_CR1           REG32(TIM2_BASE + 0x00u)
+#define TIM2_DIER          REG32(TIM2_BASE + 0x0Cu)
+#define TIM2_SR            REG32(TIM2_BASE + 0x10u)
+#define TIM2_EGR           REG32(TIM2_BASE + 0x14u)
+#define TIM2_CNT           REG32(TIM2_BASE + 0x24u)
+#define TIM2_PSC           REG32(TIM2_BASE + 0x28u)
+#define TIM2_ARR           REG32(TIM2_BASE + 0x2Cu)
+
+/* ============================
+   TIM7 basic timer (STM32L4xx)
+   ============================ */
+#define TIM7_BASE          (0x40001400u)
+#define TIM7_CR1           REG32(TIM7_BASE + 0x00u)
+#define TIM7_DIER          REG32(TIM7_BASE + 0x0Cu)
+#define TIM7_SR            REG32(TIM7_BASE + 0x10u)
+#define TIM7_EGR           REG32(TIM7_BASE + 0x14u)
+#define TIM7_PSC           REG32(TIM7_BASE + 0x28u)
+#define TIM7_ARR           REG32(TIM7_BASE + 0x2Cu)
+
+#define TIM_CR1_CEN        (1u << 0)
+#define TIM_DIER_UIE       (1u << 0)
+#define TIM_SR_UIF         (1u << 0)
+#define TIM_EGR_UG         (1u << 0)
+
+/* ============================
+   NVIC (STM32L43x)
+   ============================ */
+/* External IRQ lines 0..84; vector table is 16 + 85 words */
+#define MCU_IRQ_COUNT      (85u)
+
+/* Implemented NVIC priority bits (16 levels, in the top nibble) */
+#define MCU_NVIC_PRIO_BITS (4u)
+
+/* IRQ numbers used by this project */
+#define MCU_IRQ_WWDG       (0u)
+#define MCU_IRQ_TIM2       (28u)
+#define MCU_IRQ_TIM7       (55u)
+
 #endif /* MCU_STM32L4XX_H */
 
@@ -1,6 +1,9 @@
 /* runtime.c — minimal explicit runtime services */
 
 #include "runtime.h"
+#include "runtime_timer.h"
+#include "runtime_section.h"
+#include "runtime_trace.h"
 #include "arch_cortexm_baremetal.h"
 
 /* SysTick registers */
@@ -11,9 +14,69 @@
 #define SYST_CSR_TICKINT   (1u << 1)
 #define SYST_CSR_CLKSOURCE (1u << 2)
 
-/* Global tick counter (incremented in SysTick_Handler) */
+/* Minimum SysTick counts left in the running period before we dare to
+ * stretch the next one. Keeps the reprogramming window well clear of a wrap.
+ */
+#define TICKLESS_MARGIN    (64u)
+
+/* Global tick counter (advanced in SysTick_Handler) */
 volatile uint32_t g_systick_ms = 0;
 
+/* Upper 32 bits of the millisecond count (carry out of g_systick_ms) */
+static volatile uint32_t s_systick_ms_hi;
+
+/* Bumped once per SysTick_Handler; readers retry if it moved under them */
+static volatile uint32_t s_tick_seq;
+
+/* Tickless bookkeeping.
+ * SysTick normally wraps every 1 ms. For longer delays the reload is
+ * stretched so the next interrupt lands on the deadline, and the handler
+ * credits the whole stretched period in one go.
+ */
+static uint32_t s_ticks_per_ms;
+static uint32_t s_max_period_ms;
+static volatile uint32_t s_period_ms      = 1u; /* ms covered by running period */
+static volatile uint32_t s_next_period_ms = 1u; /* ms covered after next wrap   */
+
+/* Tick handler runs from SRAM2 unless built with TICK_RAMFUNC=0 */
+#ifdef RUNTIME_TICK_RAMFUNC
+#define TICK_PLACEMENT RUNTIME_RAMFUNC
+#else
+#define TICK_PLACEMENT
+#endif
+
+/* SysTick interrupt handler
+ * Owns system millisecond timebase.
+ * Linked into the vector table by startup.s.
+ */
+TICK_PLACEMENT void SysTick_Handler(void)
+{
+    RUNTIME_TRACE_BEGIN("systick");
+
+    uint32_t ms = g_systick_ms + s_period_ms;
+    if (ms < g_systick_ms) {
+        s_systick_ms_hi++;
+    }
+    g_systick_ms = ms;
+    s_period_ms = s_next_period_ms;
+
+    if (s_next_period_ms != 1u) {
+        /* Stretched reload is now latched in the counter; queue the
+         * return to 1 ms for the wrap that ends it.
+         */
+        SYST_RVR = s_ticks_per_ms - 1u;
+        s_next_period_ms = 1u;
+    }
+
+    s_tick_seq++;
+
+#ifndef RUNTIME_TIMER_DEFERRED
+    runtime_timer_advance(ms);
+#endif
+
+    RUNTIME_TRACE_END("systick");
+}
+
 void runtime_irq_disable(void)
 {
     arch_irq_disable();
@@ -31,8 +94,16 @@ void runtime_init(uint32_t sysclk_hz)
     SYST_RVR = 0;
     SYST_CVR = 0;
 
+    s_ticks_per_ms   = sysclk_hz / 1000u;
+    s_max_period_ms  = (SYST_RVR_MAX + 1u) / s_ticks_per_ms;
+    s_period_ms      = 1u;
+    s_next_period_ms = 1u;
+
+    /* Cycle counter backs runtime_delay_us() */
+    arch_cyccnt_enable();
+
     /* Configure SysTick for 1 kHz */
-    SYST_RVR = (sysclk_hz / 1000u) - 1u;
+    SYST_RVR = s_ticks_per_ms - 1u;
     SYST_CVR = 0;
 
     SYST_CSR = SYST_CSR_CLKSOURCE |
@@ -40,16 +111,297 @@ void runtime_init(uint32_t sysclk_hz)
                SYST_CSR_ENABLE;
 }
 
+/* Consistent view of the timebase: whole milliseconds credited so far,
+ * plus SysTick counts elapsed in the running period.
+ */
+static void timebase_read(uint64_t *ms, uint32_t *ticks)
+{
+    uint32_t seq;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t period;
+    uint32_t cvr;
+
+    do {
+        seq    = s_tick_seq;
+        lo     = g_systick_ms;
+        hi     = s_systick_ms_hi;
+        period = s_period_ms;
+        cvr    = SYST_CVR;
+
+        /* Wrapped but not yet serviced (caller has IRQs masked):
+         * credit the finished period ourselves and sample the new one.
+         * CVR still at 0 is the wrap count itself, the old period's last.
+         */
+        if (SCB_ICSR & SCB_ICSR_PENDSTSET) {
+            cvr = SYST_CVR;
+            if (cvr != 0u) {
+                uint32_t next = lo + period;
+                if (next < lo) {
+                    hi++;
+                }
+                lo     = next;
+                period = s_next_period_ms;
+            }
+        }
+    } while (seq != s_tick_seq);
+
+    *ms    = ((uint64_t)hi << 32) | lo;
+    *ticks = (period * s_ticks_per_ms - 1u) - cvr;
+}
+
+void runtime_set_sysclk(uint32_t sysclk_hz, runtime_clock_switch_fn do_switch, uint32_t arg)
+{
+    uint32_t primask = arch_irq_save();
+    uint32_t old_tpm = s_ticks_per_ms;
+    uint32_t new_tpm = sysclk_hz / 1000u;
+    uint64_t ms;
+    uint32_t ticks;
+
+    /* Freeze the timebase: credit everything up to now, pending wrap
+     * included, and keep the sub-millisecond remainder.
+     */
+    timebase_read(&ms, &ticks);
+    SYST_CSR = 0;
+    SCB_ICSR = SCB_ICSR_PENDSTCLR;
+
+    ms += ticks / old_tpm;
+    ticks %= old_tpm;
+    g_systick_ms    = (uint32_t)ms;
+    s_systick_ms_hi = (uint32_t)(ms >> 32);
+
+    do_switch(arg);
+
+    s_ticks_per_ms   = new_tpm;
+    s_max_period_ms  = (SYST_RVR_MAX + 1u) / new_tpm;
+    s_period_ms      = 1u;
+    s_next_period_ms = 1u;
+
+    /* Remainder in new-clock ticks; leave room to catch the reload below */
+    uint32_t frac = (uint32_t)(((uint64_t)ticks * new_tpm) / old_tpm);
+    if (frac > new_tpm - TICKLESS_MARGIN) {
+        frac = new_tpm - TICKLESS_MARGIN;
+    }
+
+    /* First period is trimmed by the remainder, so the next wrap still
+     * lands on a millisecond boundary. The counter latches the trimmed
+     * reload on its first clock; after that, queue the normal 1 ms.
+     */
+    SYST_RVR = (new_tpm - frac) - 1u;
+    SYST_CVR = 0;
+    SYST_CSR = SYST_CSR_CLKSOURCE |
+               SYST_CSR_TICKINT   |
+               SYST_CSR_ENABLE;
+    while (SYST_CVR == 0u) { }
+    SYST_RVR = new_tpm - 1u;
+
+    s_tick_seq++;
+    RUNTIME_TRACE_CLOCK(sysclk_hz);
+    arch_irq_restore(primask);
+}
+
 uint32_t runtime_millis(void)
 {
-    return g_systick_ms;
+    uint64_t ms;
+    uint32_t ticks;
+
+    timebase_read(&ms, &ticks);
+    return (uint32_t)ms + ticks / s_ticks_per_ms;
 }
 
-void runtime_delay_ms(uint32_t ms)
+uint64_t runtime_micros64(void)
+{
+    uint64_t ms;
+    uint32_t ticks;
+
+    timebase_read(&ms, &ticks);
+
+    /* Split so the sub-ms product stays in 32 bits (ticks % tpm < 80000) */
+    ms += ticks / s_ticks_per_ms;
+    ticks %= s_ticks_per_ms;
+
+    return ms * 1000u + (ticks * 1000u) / s_ticks_per_ms;
+}
+
+void runtime_delay_us(uint32_t us)
 {
-    uint32_t start = g_systick_ms;
-    while ((g_systick_ms - start) < ms) {
-        __asm__ volatile ("nop");
+    uint32_t start = arch_cyccnt();
+
+    /* Whole milliseconds first: s_ticks_per_ms cycles each, no rounding */
+    while (us >= 1000u) {
+        while ((arch_cyccnt() - start) < s_ticks_per_ms) { }
+        start += s_ticks_per_ms;
+        us    -= 1000u;
     }
+
+    uint32_t cycles = (us * s_ticks_per_ms) / 1000u;
+    while ((arch_cyccnt() - start) < cycles) { }
 }
 
+/* If at least 2 ms remain, stretch the period that follows the current
+ * one so the core stays parked until the deadline instead of waking every
+ * 1 ms. IRQs masked.
+ */
+static void tickless_stretch(uint32_t remaining_ms)
+{
+    if ((remaining_ms <= 1u) || (s_period_ms != 1u) || (s_next_period_ms != 1u)) {
+        return;
+    }
+
+    /* The running 1 ms period covers the first millisecond */
+    uint32_t n = remaining_ms - 1u;
+    if (n > s_max_period_ms) {
+        n = s_max_period_ms;
+    }
+
+    /* Never sleep through a tick the timer wheel has to service */
+    uint32_t due;
+    if (runtime_timer_next_due(&due)) {
+        int32_t room = (int32_t)(due - (g_systick_ms + 1u));
+        if (room < 0) {
+            room = 0;
+        }
+        if ((uint32_t)room < n) {
+            n = (uint32_t)room;
+        }
+    }
+
+    /* Only well clear of the wrap, and with CVR read before PENDSTSET
+     * as in runtime_tick_deadline()
+     */
+    if ((n > 1u) &&
+        (SYST_CVR > TICKLESS_MARGIN) &&
+        ((SCB_ICSR & SCB_ICSR_PENDSTSET) == 0u)) {
+        /* Takes effect at the next wrap; the running count is untouched */
+        SYST_RVR = n * s_ticks_per_ms - 1u;
+        s_next_period_ms = n;
+    }
+}
+
+/* A timer was just armed for due_ms, possibly while SysTick is stretched
+ * past it (armed from an ISR or task while the core was parked). Pull the
+ * next wrap back to due_ms. Called by runtime_timer_start(), IRQs masked.
+ */
+void runtime_tick_deadline(uint32_t due_ms)
+{
+    uint32_t start  = g_systick_ms;
+    uint32_t period = s_period_ms;
+
+    if (s_next_period_ms != 1u) {
+        /* Stretch queued, or latched by a wrap not serviced yet */
+        int32_t n = (int32_t)(due_ms - (start + period));
+        if (n >= (int32_t)s_next_period_ms) {
+            return;
+        }
+        if (n < 1) {
+            n = 1;
+        }
+
+        /* Not latched yet: shorten the queued reload. CVR is read
+         * first, so a wrap cannot slip in before the PENDSTSET read.
+         */
+        if ((SYST_CVR > TICKLESS_MARGIN) &&
+            ((SCB_ICSR & SCB_ICSR_PENDSTSET) == 0u)) {
+            SYST_RVR = (uint32_t)n * s_ticks_per_ms - 1u;
+            s_next_period_ms = (uint32_t)n;
+            return;
+        }
+
+        /* Too close to tell which reload the wrap takes: let it latch,
+         * then cut the running count below
+         */
+        while ((SCB_ICSR & SCB_ICSR_PENDSTSET) == 0u) { }
+    }
+
+    /* Running period: the one latched by a wrap not serviced yet, if any */
+    uint32_t pending = SCB_ICSR & SCB_ICSR_PENDSTSET;
+    if (pending != 0u) {
+        start += period;
+        period = s_next_period_ms;
+    }
+
+    uint32_t len = due_ms - start;
+    if ((int32_t)len < 1) {
+        len = 1u;
+    }
+    if (len >= period) {
+        return;
+    }
+
+    /* Past the wrap count itself, so CVR belongs to the running period.
+     * If a wrap slipped in after the PENDSTSET read, this is a 1 ms
+     * period: too short for the cut below, which then backs off.
+     */
+    uint32_t cvr;
+    while ((cvr = SYST_CVR) == 0u) { }
+
+    /* The new wrap must stay TICKLESS_MARGIN counts ahead; a deadline
+     * closer than that moves it to the next millisecond.
+     */
+    while ((len < period) &&
+           (cvr < (period - len) * s_ticks_per_ms + 1u + TICKLESS_MARGIN)) {
+        len++;
+    }
+    if (len >= period) {
+        return;
+    }
+
+    /* Cut (period - len) ms off the running count. Clearing CVR reloads
+     * it from RVR on the next count, without an exception; that count
+     * stands in for the one the clear lands on. The few counts between
+     * the read and the clear are lost, as in runtime_set_sysclk().
+     */
+    uint32_t cut = (period - len) * s_ticks_per_ms;
+    cvr = SYST_CVR;
+    SYST_RVR = cvr - cut - 1u;
+    SYST_CVR = 0u;
+    while (SYST_CVR == 0u) { }
+    SYST_RVR = s_ticks_per_ms - 1u;
+
+    if (pending != 0u) {
+        s_next_period_ms = len;     /* the handler latches it */
+    } else {
+        s_period_ms      = len;
+        s_next_period_ms = 1u;
+    }
+
+    /* A timebase_read() this preempted must not mix the two periods */
+    s_tick_seq++;
+}
+
+/* Sleep until the next SysTick (or any other) interrupt */
+static void tickless_wait(uint32_t remaining_ms)
+{
+    arch_irq_disable();
+    tickless_stretch(remaining_ms);
+    arch_wfi();
+    arch_irq_enable();
+}
+
+void runtime_idle(void)
+{
+    tickless_wait(UINT32_MAX);
+}
+
+void runtime_wait_event(void)
+{
+    arch_irq_disable();
+    tickless_stretch(UINT32_MAX);
+    arch_irq_enable();
+    arch_wfe();
+}
+
+void runtime_delay_ms(uint32_t ms)
+{
+    uint32_t start = runtime_millis();
+
+    RUNTIME_TRACE_BEGIN("delay_ms");
+    for (;;) {
+        uint32_t elapsed = runtime_millis() - start;
+        if (elapsed >= ms) {
+            break;
+        }
+        tickless_wait(ms - elapsed);
+    }
+    RUNTIME_TRACE_END("delay_ms");
+}
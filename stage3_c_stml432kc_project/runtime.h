@@ -1,7 +1,8 @@
 /* runtime.h — minimal explicit runtime services
  *
  * Owns timebase, interrupt policy, and critical sections.
- * No libc. No allocation. No side effects beyond what is documented.
+ * No libc. No heap: fixed-block pools only (runtime_pool.h).
+ * No side effects beyond what is documented.
  */
 
 #ifndef RUNTIME_H
@@ -14,13 +15,60 @@
  */
 void runtime_init(uint32_t sysclk_hz);
 
-/* Millisecond time since runtime_init() */
+/* Performs the actual clock switch (e.g. init_clock_profile), IRQs masked */
+typedef void (*runtime_clock_switch_fn)(uint32_t arg);
+
+/* Change SYSCLK at run time.
+ * Calls do_switch(arg) with SysTick stopped, then re-derives every
+ * SYSCLK-based constant (SysTick reload, delay calibration) for sysclk_hz.
+ * runtime_millis()/runtime_micros64() stay continuous across the switch;
+ * only the time spent inside do_switch() itself is not accounted for.
+ * Not for use while a runtime_delay_us() is spinning in another context.
+ */
+void runtime_set_sysclk(uint32_t sysclk_hz, runtime_clock_switch_fn do_switch, uint32_t arg);
+
+/* Millisecond time since runtime_init() (wraps after ~49 days) */
 uint32_t runtime_millis(void);
 
-/* Sleep for at least ms milliseconds */
+/* Microsecond time since runtime_init().
+ * 64-bit, never wraps in practice. Combines the tick count with the live
+ * SysTick down-counter; safe against a concurrent SysTick_Handler.
+ */
+uint64_t runtime_micros64(void);
+
+/* Sleep for at least ms milliseconds.
+ * Tickless: the core waits in WFI and SysTick is stretched to fire at the
+ * deadline, so runtime_millis() stays exact across the wait.
+ */
 void runtime_delay_ms(uint32_t ms);
 
-/* Explicit critical section control */
+/* Park the core until the next interrupt.
+ * SysTick is stretched as far as the next timer wheel deadline allows.
+ */
+void runtime_idle(void);
+
+/* Park the core until an event: any interrupt taken since the previous
+ * call, or an arch_sev(). Tickless like runtime_idle(), but with IRQs
+ * left enabled around WFE, so a caller can check its queues and then
+ * wait without a lost-wakeup race (runtime_event.h).
+ */
+void runtime_wait_event(void);
+
+/* For runtime_timer_start(), IRQs masked: a timer was armed for due_ms.
+ * If SysTick is stretched past it, the next wrap is pulled back to
+ * due_ms, so a timer armed while the core is parked is not late.
+ */
+void runtime_tick_deadline(uint32_t due_ms);
+
+/* Busy-wait for at least us microseconds.
+ * Counted in core cycles (DWT CYCCNT), so it needs no interrupts and adds
+ * no SysTick load. Meant for short sub-millisecond waits.
+ */
+void runtime_delay_us(uint32_t us);
+
+/* Global IRQ on/off, for boot sequencing. Does not nest: critical
+ * sections use runtime_crit_enter()/_enter_prio() (runtime_irq.h).
+ */
 void runtime_irq_disable(void);
 void runtime_irq_enable(void);
 
@@ -0,0 +1,366 @@
+/* runtime_dsp.c — fixed-point DSP kernels (Q15 / Q31) */
+
+#include "runtime_dsp.h"
+#include "arch_cortexm_dsp.h"
+
+/* ============================
+   Helpers
+   ============================ */
+
+static inline int32_t sat_q31(int64_t x)
+{
+    if (x > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (x < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)x;
+}
+
+static inline void pair_store(runtime_q15_t *p, uint32_t v)
+{
+    __builtin_memcpy(p, &v, sizeof v);
+}
+
+/* One FIR output: sum(coef[k] * newest[-k]).
+ * A coefficient pair {c[k], c[k+1]} meets the sample pair {x[-k-1], x[-k]}
+ * in reverse order, hence the exchanged MAC.
+ */
+static int32_t fir_q15_point(const runtime_q15_t *coef, const runtime_q15_t *newest,
+                             uint32_t taps)
+{
+    int64_t  acc = 0;
+    uint32_t k   = 0;
+
+    for (; (k + 4u) <= taps; k += 4u) {
+        acc = arch_smlaldx(arch_pair_load(&coef[k]), arch_pair_load(newest - k - 1), acc);
+        acc = arch_smlaldx(arch_pair_load(&coef[k + 2u]), arch_pair_load(newest - k - 3), acc);
+    }
+    for (; (k + 2u) <= taps; k += 2u) {
+        acc = arch_smlaldx(arch_pair_load(&coef[k]), arch_pair_load(newest - k - 1), acc);
+    }
+    if (k < taps) {
+        acc += (int32_t)coef[k] * newest[-(int32_t)k];
+    }
+    return arch_ssat16((int32_t)(acc >> 15));
+}
+
+static int32_t fir_q31_point(const runtime_q31_t *coef, const runtime_q31_t *newest,
+                             uint32_t taps)
+{
+    int64_t acc = 0;
+
+    for (uint32_t k = 0; k < taps; k++) {
+        acc += (int64_t)coef[k] * newest[-(int32_t)k];
+    }
+    return sat_q31(acc >> 31);
+}
+
+/* ============================
+   Dot product
+   ============================ */
+
+int64_t runtime_dsp_dot_q15(const runtime_q15_t *a, const runtime_q15_t *b, uint32_t n)
+{
+    int64_t  acc = 0;
+    uint32_t i   = 0;
+
+    for (; (i + 4u) <= n; i += 4u) {
+        acc = arch_smlald(arch_pair_load(&a[i]), arch_pair_load(&b[i]), acc);
+        acc = arch_smlald(arch_pair_load(&a[i + 2u]), arch_pair_load(&b[i + 2u]), acc);
+    }
+    for (; i < n; i++) {
+        acc += (int32_t)a[i] * b[i];
+    }
+    return acc;
+}
+
+int64_t runtime_dsp_dot_q31(const runtime_q31_t *a, const runtime_q31_t *b, uint32_t n)
+{
+    int64_t acc = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        acc += ((int64_t)a[i] * b[i]) >> 14;
+    }
+    return acc;
+}
+
+/* ============================
+   FIR and FIR decimator
+   ============================ */
+
+void runtime_dsp_fir_q15_init(runtime_dsp_fir_q15_t *f, const runtime_q15_t *coef,
+                              uint32_t taps, runtime_q15_t *state, uint32_t block_max)
+{
+    f->coef      = coef;
+    f->state     = state;
+    f->taps      = taps;
+    f->block_max = block_max;
+    for (uint32_t i = 0; i < taps - 1u + block_max; i++) {
+        state[i] = 0;
+    }
+}
+
+/* Append a block behind the history; returns the newest history slot */
+static runtime_q15_t *fir_q15_append(runtime_dsp_fir_q15_t *f, const runtime_q15_t *in,
+                                     uint32_t n)
+{
+    runtime_q15_t *s = f->state + f->taps - 1u;
+    for (uint32_t i = 0; i < n; i++) {
+        s[i] = in[i];
+    }
+    return s;
+}
+
+/* Keep the last taps - 1 samples as history for the next block */
+static void fir_q15_retire(runtime_dsp_fir_q15_t *f, uint32_t n)
+{
+    for (uint32_t i = 0; i < f->taps - 1u; i++) {
+        f->state[i] = f->state[n + i];
+    }
+}
+
+void runtime_dsp_fir_q15(runtime_dsp_fir_q15_t *f, const runtime_q15_t *in,
+                         runtime_q15_t *out, uint32_t n)
+{
+    const runtime_q15_t *s = fir_q15_append(f, in, n);
+
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = (runtime_q15_t)fir_q15_point(f->coef, &s[i], f->taps);
+    }
+    fir_q15_retire(f, n);
+}
+
+uint32_t runtime_dsp_decimate_q15(runtime_dsp_fir_q15_t *f, const runtime_q15_t *in,
+                                  runtime_q15_t *out, uint32_t n, uint32_t factor)
+{
+    const runtime_q15_t *s = fir_q15_append(f, in, n);
+    uint32_t m = 0;
+
+    for (uint32_t i = factor - 1u; i < n; i += factor) {
+        out[m++] = (runtime_q15_t)fir_q15_point(f->coef, &s[i], f->taps);
+    }
+    fir_q15_retire(f, n);
+    return m;
+}
+
+void runtime_dsp_fir_q31_init(runtime_dsp_fir_q31_t *f, const runtime_q31_t *coef,
+                              uint32_t taps, runtime_q31_t *state, uint32_t block_max)
+{
+    f->coef      = coef;
+    f->state     = state;
+    f->taps      = taps;
+    f->block_max = block_max;
+    for (uint32_t i = 0; i < taps - 1u + block_max; i++) {
+        state[i] = 0;
+    }
+}
+
+static runtime_q31_t *fir_q31_append(runtime_dsp_fir_q31_t *f, const runtime_q31_t *in,
+                                     uint32_t n)
+{
+    runtime_q31_t *s = f->state + f->taps - 1u;
+    for (uint32_t i = 0; i < n; i++) {
+        s[i] = in[i];
+    }
+    return s;
+}
+
+static void fir_q31_retire(runtime_dsp_fir_q31_t *f, uint32_t n)
+{
+    for (uint32_t i = 0; i < f->taps - 1u; i++) {
+        f->state[i] = f->state[n + i];
+    }
+}
+
+void runtime_dsp_fir_q31(runtime_dsp_fir_q31_t *f, const runtime_q31_t *in,
+                         runtime_q31_t *out, uint32_t n)
+{
+    const runtime_q31_t *s = fir_q31_append(f, in, n);
+
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = fir_q31_point(f->coef, &s[i], f->taps);
+    }
+    fir_q31_retire(f, n);
+}
+
+uint32_t runtime_dsp_decimate_q31(runtime_dsp_fir_q31_t *f, const runtime_q31_t *in,
+                                  runtime_q31_t *out, uint32_t n, uint32_t factor)
+{
+    const runtime_q31_t *s = fir_q31_append(f, in, n);
+    uint32_t m = 0;
+
+    for (uint32_t i = factor - 1u; i < n; i += factor) {
+        out[m++] = fir_q31_point(f->coef, &s[i], f->taps);
+    }
+    fir_q31_retire(f, n);
+    return m;
+}
+
+/* ============================
+   Biquad IIR
+   ============================ */
+
+void runtime_dsp_biquad_q15_init(runtime_dsp_biquad_q15_t *f, const runtime_q15_t *coef,
+                                 uint32_t stages, runtime_q15_t *state, uint32_t post_shift)
+{
+    f->coef       = coef;
+    f->state      = state;
+    f->stages     = stages;
+    f->post_shift = post_shift;
+    for (uint32_t i = 0; i < 4u * stages; i++) {
+        state[i] = 0;
+    }
+}
+
+/* History stays packed in two registers: x = {x[n-1], x[n-2]},
+ * y = {y[n-1], y[n-2]}; PKHBT shifts a new sample in.
+ */
+void runtime_dsp_biquad_q15(runtime_dsp_biquad_q15_t *f, const runtime_q15_t *in,
+                            runtime_q15_t *out, uint32_t n)
+{
+    const runtime_q15_t *src   = in;
+    uint32_t             shift = 15u - f->post_shift;
+
+    for (uint32_t s = 0; s < f->stages; s++) {
+        const runtime_q15_t *c   = &f->coef[5u * s];
+        runtime_q15_t       *st  = &f->state[4u * s];
+        int32_t              b0  = c[0];
+        uint32_t             b12 = arch_pair_load(&c[1]);
+        uint32_t             a12 = arch_pair_load(&c[3]);
+        uint32_t             x   = arch_pair_load(&st[0]);
+        uint32_t             y   = arch_pair_load(&st[2]);
+
+        for (uint32_t i = 0; i < n; i++) {
+            int32_t x0  = src[i];
+            int64_t acc = (int64_t)(b0 * x0);
+
+            acc = arch_smlald(b12, x, acc);
+            acc = arch_smlald(a12, y, acc);
+
+            int32_t y0 = arch_ssat16((int32_t)(acc >> shift));
+            x = arch_pkhbt((uint32_t)x0, x);
+            y = arch_pkhbt((uint32_t)y0, y);
+            out[i] = (runtime_q15_t)y0;
+        }
+
+        pair_store(&st[0], x);
+        pair_store(&st[2], y);
+        src = out;   /* next stage filters this one's output in place */
+    }
+}
+
+void runtime_dsp_biquad_q31_init(runtime_dsp_biquad_q31_t *f, const runtime_q31_t *coef,
+                                 uint32_t stages, runtime_q31_t *state, uint32_t post_shift)
+{
+    f->coef       = coef;
+    f->state      = state;
+    f->stages     = stages;
+    f->post_shift = post_shift;
+    for (uint32_t i = 0; i < 4u * stages; i++) {
+        state[i] = 0;
+    }
+}
+
+void runtime_dsp_biquad_q31(runtime_dsp_biquad_q31_t *f, const runtime_q31_t *in,
+                            runtime_q31_t *out, uint32_t n)
+{
+    const runtime_q31_t *src   = in;
+    uint32_t             shift = 31u - f->post_shift;
+
+    for (uint32_t s = 0; s < f->stages; s++) {
+        const runtime_q31_t *c  = &f->coef[5u * s];
+        runtime_q31_t       *st = &f->state[4u * s];
+        int32_t x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+
+        for (uint32_t i = 0; i < n; i++) {
+            int32_t x0  = src[i];
+            int64_t acc = (int64_t)c[0] * x0;
+
+            acc += (int64_t)c[1] * x1;
+            acc += (int64_t)c[2] * x2;
+            acc += (int64_t)c[3] * y1;
+            acc += (int64_t)c[4] * y2;
+
+            int32_t y0 = sat_q31(acc >> shift);
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            out[i] = y0;
+        }
+
+        st[0] = x1;
+        st[1] = x2;
+        st[2] = y1;
+        st[3] = y2;
+        src = out;
+    }
+}
+
+/* ============================
+   Moving average
+   ============================ */
+
+void runtime_dsp_movavg_q15_init(runtime_dsp_movavg_q15_t *m, runtime_q15_t *window,
+                                 uint32_t shift)
+{
+    m->window = window;
+    m->shift  = shift;
+    m->pos    = 0;
+    m->sum    = 0;
+    for (uint32_t i = 0; i < (1u << shift); i++) {
+        window[i] = 0;
+    }
+}
+
+void runtime_dsp_movavg_q15(runtime_dsp_movavg_q15_t *m, const runtime_q15_t *in,
+                            runtime_q15_t *out, uint32_t n)
+{
+    uint32_t mask = (1u << m->shift) - 1u;
+    uint32_t pos  = m->pos;
+    int32_t  sum  = m->sum;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t x0 = in[i];
+        sum += x0 - m->window[pos];
+        m->window[pos] = (runtime_q15_t)x0;
+        pos = (pos + 1u) & mask;
+        out[i] = (runtime_q15_t)(sum >> m->shift);
+    }
+
+    m->pos = pos;
+    m->sum = sum;
+}
+
+void runtime_dsp_movavg_q31_init(runtime_dsp_movavg_q31_t *m, runtime_q31_t *window,
+                                 uint32_t shift)
+{
+    m->window = window;
+    m->shift  = shift;
+    m->pos    = 0;
+    m->sum    = 0;
+    for (uint32_t i = 0; i < (1u << shift); i++) {
+        window[i] = 0;
+    }
+}
+
+void runtime_dsp_movavg_q31(runtime_dsp_movavg_q31_t *m, const runtime_q31_t *in,
+                            runtime_q31_t *out, uint32_t n)
+{
+    uint32_t mask = (1u << m->shift) - 1u;
+    uint32_t pos  = m->pos;
+    int64_t  sum  = m->sum;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t x0 = in[i];
+        sum += (int64_t)x0 - m->window[pos];
+        m->window[pos] = x0;
+        pos = (pos + 1u) & mask;
+        out[i] = (runtime_q31_t)(sum >> m->shift);
+    }
+
+    m->pos = pos;
+    m->sum = sum;
+}
@@ -0,0 +1,149 @@
+/* runtime_dsp.h — fixed-point DSP kernels (Q15 / Q31)
+ *
+ * Q15: int16_t in [-1, 1), 15 fractional bits. Q31: int32_t, 31 bits.
+ * Products accumulate in 64 bits and are rounded down (arithmetic shift)
+ * once per output, then saturated. The Q15 kernels process two samples
+ * per instruction with the M4 packed-halfword MACs (arch_cortexm_dsp.h);
+ * Q31 uses the 32x32 -> 64 multiply-accumulate (SMLAL).
+ *
+ * Filters keep their history in caller-supplied state; nothing is
+ * allocated, nothing is global, and every call is bounded by its block
+ * length. Blocks may be processed in place (in == out).
+ *
+ * Without the DSP extension (host compiler) the same file builds as the
+ * portable reference with bit-identical results: `make dsp-ref` prints
+ * the checksums `make BENCH=dsp` must reproduce on target.
+ */
+
+#ifndef RUNTIME_DSP_H
+#define RUNTIME_DSP_H
+
+#include <stdint.h>
+
+typedef int16_t runtime_q15_t;
+typedef int32_t runtime_q31_t;
+
+/* ============================
+   Dot product
+   ============================ */
+
+/* sum(a[i] * b[i]) in 34.30 format, exact */
+int64_t runtime_dsp_dot_q15(const runtime_q15_t *a, const runtime_q15_t *b, uint32_t n);
+
+/* sum((a[i] * b[i]) >> 14) in 16.48 format (exact for n < 2^15) */
+int64_t runtime_dsp_dot_q31(const runtime_q31_t *a, const runtime_q31_t *b, uint32_t n);
+
+/* ============================
+   FIR and FIR decimator
+   ============================ */
+
+/* y[n] = sum(coef[k] * x[n - k]), k = 0 .. taps - 1: coef[0] weighs the
+ * newest sample. State holds taps - 1 samples of history plus one block.
+ */
+#define RUNTIME_DSP_FIR_STATE(name, type, taps, block_max) \
+    static type name[(taps) - 1u + (block_max)]
+
+typedef struct {
+    const runtime_q15_t *coef;
+    runtime_q15_t       *state;
+    uint32_t             taps;
+    uint32_t             block_max;   /* most samples per call */
+} runtime_dsp_fir_q15_t;
+
+/* Q31: sum(|coef|) < 2.0 keeps the 64-bit accumulator from overflowing */
+typedef struct {
+    const runtime_q31_t *coef;
+    runtime_q31_t       *state;
+    uint32_t             taps;
+    uint32_t             block_max;
+} runtime_dsp_fir_q31_t;
+
+void runtime_dsp_fir_q15_init(runtime_dsp_fir_q15_t *f, const runtime_q15_t *coef,
+                              uint32_t taps, runtime_q15_t *state, uint32_t block_max);
+void runtime_dsp_fir_q15(runtime_dsp_fir_q15_t *f, const runtime_q15_t *in,
+                         runtime_q15_t *out, uint32_t n);
+
+void runtime_dsp_fir_q31_init(runtime_dsp_fir_q31_t *f, const runtime_q31_t *coef,
+                              uint32_t taps, runtime_q31_t *state, uint32_t block_max);
+void runtime_dsp_fir_q31(runtime_dsp_fir_q31_t *f, const runtime_q31_t *in,
+                         runtime_q31_t *out, uint32_t n);
+
+/* Filter and keep every factor-th output (the one after the newest
+ * sample of each group): n must be a multiple of factor. Only the kept
+ * outputs are computed. Returns n / factor.
+ */
+uint32_t runtime_dsp_decimate_q15(runtime_dsp_fir_q15_t *f, const runtime_q15_t *in,
+                                  runtime_q15_t *out, uint32_t n, uint32_t factor);
+uint32_t runtime_dsp_decimate_q31(runtime_dsp_fir_q31_t *f, const runtime_q31_t *in,
+                                  runtime_q31_t *out, uint32_t n, uint32_t factor);
+
+/* ============================
+   Biquad IIR (direct form I cascade)
+   ============================ */
+
+/* Per stage, 5 coefficients {b0, b1, b2, a1, a2} and 4 state words
+ * {x[n-1], x[n-2], y[n-1], y[n-2]}:
+ *
+ *   y[n] = (b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]) << post_shift
+ *
+ * a1/a2 are negated from the textbook form. Coefficients above 1.0 are
+ * stored scaled by 2^-post_shift. Q31: the five (scaled) |coefficients|
+ * must sum below 2.0, as for the FIR.
+ */
+typedef struct {
+    const runtime_q15_t *coef;
+    runtime_q15_t       *state;
+    uint32_t             stages;
+    uint32_t             post_shift;  /* 0 .. 15 */
+} runtime_dsp_biquad_q15_t;
+
+typedef struct {
+    const runtime_q31_t *coef;
+    runtime_q31_t       *state;
+    uint32_t             stages;
+    uint32_t             post_shift;  /* 0 .. 31 */
+} runtime_dsp_biquad_q31_t;
+
+void runtime_dsp_biquad_q15_init(runtime_dsp_biquad_q15_t *f, const runtime_q15_t *coef,
+                                 uint32_t stages, runtime_q15_t *state, uint32_t post_shift);
+void runtime_dsp_biquad_q15(runtime_dsp_biquad_q15_t *f, const runtime_q15_t *in,
+                            runtime_q15_t *out, uint32_t n);
+
+void runtime_dsp_biquad_q31_init(runtime_dsp_biquad_q31_t *f, const runtime_q31_t *coef,
+                                 uint32_t stages, runtime_q31_t *state, uint32_t post_shift);
+void runtime_dsp_biquad_q31(runtime_dsp_biquad_q31_t *f, const runtime_q31_t *in,
+                            runtime_q31_t *out, uint32_t n);
+
+/* ============================
+   Moving average
+   ============================ */
+
+/* Mean of the last 2^shift samples (rounded down), O(1) per sample from
+ * a running sum. The window starts as zeros. Q15: shift <= 16.
+ */
+typedef struct {
+    runtime_q15_t *window;   /* 2^shift samples */
+    uint32_t       shift;
+    uint32_t       pos;
+    int32_t        sum;
+} runtime_dsp_movavg_q15_t;
+
+/* Q31: shift <= 31 */
+typedef struct {
+    runtime_q31_t *window;
+    uint32_t       shift;
+    uint32_t       pos;
+    int64_t        sum;
+} runtime_dsp_movavg_q31_t;
+
+void runtime_dsp_movavg_q15_init(runtime_dsp_movavg_q15_t *m, runtime_q15_t *window,
+                                 uint32_t shift);
+void runtime_dsp_movavg_q15(runtime_dsp_movavg_q15_t *m, const runtime_q15_t *in,
+                            runtime_q15_t *out, uint32_t n);
+
+void runtime_dsp_movavg_q31_init(runtime_dsp_movavg_q31_t *m, runtime_q31_t *window,
+                                 uint32_t shift);
+void runtime_dsp_movavg_q31(runtime_dsp_movavg_q31_t *m, const runtime_q31_t *in,
+                            runtime_q31_t *out, uint32_t n);
+
+#endif /* RUNTIME_DSP_H */
@@ -0,0 +1,207 @@
+/* runtime_event.c — event bus from ISRs to the main loop */
+
+#include "runtime_event.h"
+#include "runtime.h"
+#include "runtime_irq.h"
+#include "arch_cortexm_baremetal.h"
+
+_Static_assert((RUNTIME_EVENT_QUEUE_LEN & (RUNTIME_EVENT_QUEUE_LEN - 1u)) == 0u,
+               "RUNTIME_EVENT_QUEUE_LEN must be a power of two");
+
+runtime_event_queue_t g_event_queue[RUNTIME_EVENT_PRIOS];
+
+static runtime_event_t s_event_storage[RUNTIME_EVENT_PRIOS][RUNTIME_EVENT_QUEUE_LEN];
+
+static runtime_event_handler_t s_handler[RUNTIME_EVENT_IDS];
+static runtime_task_t         *s_consumer;
+
+void runtime_event_init(void)
+{
+    for (uint32_t p = 0; p < RUNTIME_EVENT_PRIOS; p++) {
+        runtime_event_queue_t *q = &g_event_queue[p];
+
+        runtime_ring_init(&q->ring, s_event_storage[p],
+                          sizeof(runtime_event_t), RUNTIME_EVENT_QUEUE_LEN);
+        q->posted     = 0;
+        q->dropped    = 0;
+        q->depth_max  = 0;
+        q->dispatched = 0;
+        q->unhandled  = 0;
+        q->batches    = 0;
+        q->lat_min    = UINT32_MAX;
+        q->lat_max    = 0;
+        q->lat_sum    = 0;
+    }
+    for (uint32_t id = 0; id < RUNTIME_EVENT_IDS; id++) {
+        s_handler[id] = 0;
+    }
+    s_consumer = 0;
+}
+
+int runtime_event_register(uint32_t id, runtime_event_handler_t handler)
+{
+    if (id >= RUNTIME_EVENT_IDS) {
+        return -1;
+    }
+    s_handler[id] = handler;
+    return 0;
+}
+
+void runtime_event_set_consumer(runtime_task_t *task)
+{
+    s_consumer = task;
+}
+
+/* ============================
+   Producer side (any context)
+   ============================ */
+
+static int post(uint32_t prio, uint32_t id, uint32_t arg,
+                runtime_pool_t *pool, void *data, uint32_t len)
+{
+    runtime_event_queue_t *q;
+    runtime_event_t       *ev;
+    uint32_t               granted;
+    uint32_t               depth;
+
+    if ((prio >= RUNTIME_EVENT_PRIOS) || (id >= RUNTIME_EVENT_IDS)) {
+        return -1;
+    }
+    q = &g_event_queue[prio];
+
+    /* Producers are any thread or ISR: serialize the reserve / commit.
+     * The consumer stays lock-free on the other side.
+     */
+    runtime_crit_t crit = runtime_crit_enter();
+
+    ev = (runtime_event_t *)runtime_ring_reserve(&q->ring, 1u, &granted);
+    if (granted == 0u) {
+        q->dropped++;
+        runtime_crit_exit(crit);
+        return -1;
+    }
+
+    ev->id    = (uint16_t)id;
+    ev->len   = (uint16_t)len;
+    ev->arg   = arg;
+    ev->data  = data;
+    ev->pool  = pool;
+    ev->stamp = arch_cyccnt();
+    runtime_ring_commit(&q->ring, 1u);
+
+    q->posted++;
+    depth = q->ring.head - q->ring.tail;
+    if (depth > q->depth_max) {
+        q->depth_max = depth;
+    }
+
+    runtime_crit_exit(crit);
+
+    /* Wake the consumer: its task, or a WFE in runtime_wait_event() */
+    if (s_consumer != 0) {
+        runtime_sched_wake(s_consumer);
+    } else {
+        arch_sev();
+    }
+    return 0;
+}
+
+int runtime_event_post(uint32_t prio, uint32_t id, uint32_t arg)
+{
+    return post(prio, id, arg, 0, 0, 0u);
+}
+
+int runtime_event_post_buf(uint32_t prio, uint32_t id,
+                           runtime_pool_t *pool, void *blk, uint32_t len)
+{
+    if (post(prio, id, 0u, pool, blk, len) != 0) {
+        (void)runtime_pool_free(pool, blk);
+        return -1;
+    }
+    return 0;
+}
+
+/* ============================
+   Consumer side
+   ============================ */
+
+uint32_t runtime_event_pending(void)
+{
+    uint32_t n = 0;
+
+    for (uint32_t p = 0; p < RUNTIME_EVENT_PRIOS; p++) {
+        n += runtime_ring_count(&g_event_queue[p].ring);
+    }
+    return n;
+}
+
+/* Handle up to max events in place from the readable span of q */
+static uint32_t dispatch_batch(runtime_event_queue_t *q, uint32_t max)
+{
+    uint32_t               avail;
+    const runtime_event_t *ev = (const runtime_event_t *)runtime_ring_peek(&q->ring, &avail);
+
+    if (avail > max) {
+        avail = max;
+    }
+
+    for (uint32_t i = 0; i < avail; i++, ev++) {
+        runtime_event_handler_t handler = s_handler[ev->id];
+        uint32_t                lat     = arch_cyccnt() - ev->stamp;
+
+        if (lat < q->lat_min) {
+            q->lat_min = lat;
+        }
+        if (lat > q->lat_max) {
+            q->lat_max = lat;
+        }
+        q->lat_sum += lat;
+
+        if (handler != 0) {
+            handler(ev);
+        } else {
+            q->unhandled++;
+        }
+        if (ev->data != 0) {
+            (void)runtime_pool_free(ev->pool, ev->data);
+        }
+    }
+
+    q->dispatched += avail;
+    q->batches++;
+    runtime_ring_release(&q->ring, avail);
+    return avail;
+}
+
+uint32_t runtime_event_dispatch(uint32_t max)
+{
+    uint32_t done = 0;
+    uint32_t p    = 0;
+
+    while ((done < max) && (p < RUNTIME_EVENT_PRIOS)) {
+        if (runtime_ring_count(&g_event_queue[p].ring) == 0u) {
+            p++;
+            continue;
+        }
+        done += dispatch_batch(&g_event_queue[p], max - done);
+        p = 0;
+    }
+    return done;
+}
+
+void runtime_event_wait(void)
+{
+    if (s_consumer != 0) {
+        /* A post between the check and the block would be a lost wakeup:
+         * mask it out. The switch happens at crit exit; a post masked
+         * meanwhile runs first and makes the task ready again.
+         */
+        runtime_crit_t crit = runtime_crit_enter();
+        if (runtime_event_pending() == 0u) {
+            runtime_sched_block();
+        }
+        runtime_crit_exit(crit);
+    } else if (runtime_event_pending() == 0u) {
+        runtime_wait_event();
+    }
+}
@@ -0,0 +1,124 @@
+/* runtime_event.h — event bus from ISRs to the main loop
+ *
+ * Interrupts (or the thread) post small fixed-size events into one of
+ * RUNTIME_EVENT_PRIOS queues, 0 most urgent. One consumer, the main loop
+ * or a single scheduler task, drains them in batches and calls the
+ * handler registered for each event id:
+ *
+ *   runtime_event_register(EV_RX, on_rx);
+ *   for (;;) {
+ *       runtime_event_dispatch(RUNTIME_EVENT_BATCH);
+ *       runtime_event_wait();          // WFE until something is posted
+ *   }
+ *
+ * - each queue is a runtime_ring_t of runtime_event_t; handlers get a
+ *   pointer into the ring slot itself (no copy out), and the slots go
+ *   back to the producers once the batch is done
+ * - bulk data travels as a buffer handle: a runtime_pool block posted
+ *   with runtime_event_post_buf(), freed by the dispatcher after the
+ *   handler returns
+ * - posting takes a PRIMASK section of a few instructions, so ISRs of any
+ *   priority and the thread may all post to the same queue
+ * - per queue: posted, dropped, peak depth, dispatched, and post-to-handler
+ *   latency in CYCCNT cycles:
+ *
+ *     (gdb) p g_event_queue
+ *
+ * Storage is static (RUNTIME_EVENT_PRIOS x RUNTIME_EVENT_QUEUE_LEN events).
+ */
+
+#ifndef RUNTIME_EVENT_H
+#define RUNTIME_EVENT_H
+
+#include <stdint.h>
+#include "runtime_ring.h"
+#include "runtime_pool.h"
+#include "runtime_sched.h"
+
+/* Priority queues, 0 (dispatched first) .. RUNTIME_EVENT_PRIOS-1 */
+#ifndef RUNTIME_EVENT_PRIOS
+#define RUNTIME_EVENT_PRIOS      (4u)
+#endif
+
+/* Events per queue (power of two) */
+#ifndef RUNTIME_EVENT_QUEUE_LEN
+#define RUNTIME_EVENT_QUEUE_LEN  (16u)
+#endif
+
+/* Event ids 0 .. RUNTIME_EVENT_IDS-1 */
+#ifndef RUNTIME_EVENT_IDS
+#define RUNTIME_EVENT_IDS        (32u)
+#endif
+
+/* A sensible dispatch budget per main-loop pass */
+#define RUNTIME_EVENT_BATCH      (8u)
+
+typedef struct {
+    uint16_t        id;
+    uint16_t        len;        /* bytes of data in use (buffer events) */
+    uint32_t        arg;        /* small payload */
+    void           *data;       /* pool block, or NULL */
+    runtime_pool_t *pool;       /* data's pool */
+    uint32_t        stamp;      /* CYCCNT when posted */
+} runtime_event_t;
+
+/* Called in the consumer's context. ev (and ev->data) are valid until
+ * the handler returns; keep a copy of anything needed later.
+ */
+typedef void (*runtime_event_handler_t)(const runtime_event_t *ev);
+
+typedef struct {
+    runtime_ring_t ring;
+    uint32_t       posted;
+    uint32_t       dropped;     /* posts that found the queue full */
+    uint32_t       depth_max;   /* most events queued at once */
+    uint32_t       dispatched;
+    uint32_t       unhandled;   /* ids with no handler registered */
+    uint32_t       batches;     /* dispatch spans taken from this queue */
+    uint32_t       lat_min;     /* post -> handler entry, cycles */
+    uint32_t       lat_max;
+    uint64_t       lat_sum;     /* mean = lat_sum / dispatched */
+} runtime_event_queue_t;
+
+extern runtime_event_queue_t g_event_queue[RUNTIME_EVENT_PRIOS];
+
+/* Empty queues, no handlers, statistics cleared */
+void runtime_event_init(void);
+
+/* Route id to handler (NULL removes it). Returns 0, or -1 if id is out
+ * of range.
+ */
+int runtime_event_register(uint32_t id, runtime_event_handler_t handler);
+
+/* Post an event carrying arg. Any context. Returns 0, or -1 if the
+ * queue is full (counted in dropped) or prio / id is out of range.
+ */
+int runtime_event_post(uint32_t prio, uint32_t id, uint32_t arg);
+
+/* Post the pool block blk, len bytes used. Ownership passes to the bus
+ * in every case: on failure blk goes straight back to pool.
+ */
+int runtime_event_post_buf(uint32_t prio, uint32_t id,
+                           runtime_pool_t *pool, void *blk, uint32_t len);
+
+/* Consumer: dispatch up to max events, most urgent queue first. After
+ * each batch the more urgent queues are looked at again, so an event
+ * posted meanwhile overtakes the rest. Returns the number dispatched.
+ */
+uint32_t runtime_event_dispatch(uint32_t max);
+
+/* Events queued, all priorities */
+uint32_t runtime_event_pending(void);
+
+/* Consumer: return once something may be pending. Without a consumer
+ * task this is runtime_wait_event() (tickless WFE); with one, the task
+ * blocks and a post wakes it.
+ */
+void runtime_event_wait(void);
+
+/* Run the consumer as a scheduler task (NULL: back to the main loop).
+ * Set before anything posts.
+ */
+void runtime_event_set_consumer(runtime_task_t *task);
+
+#endif /* RUNTIME_EVENT_H */
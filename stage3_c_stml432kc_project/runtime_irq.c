@@ -0,0 +1,91 @@
+/* runtime_irq.c — interrupt registration and priorities */
+
+#include "runtime_irq.h"
+
+/* First external IRQ slot in the vector table */
+#define VECTOR_IRQ0  (16u)
+
+/* startup.s: flash table; linker.ld: its RAM copy (VTOR target) */
+extern const uint32_t g_pfnVectors[];
+extern uint32_t       __vectors_ram_start[];
+
+static inline uint32_t irq_bit(uint32_t irqn)
+{
+    return 1u << (irqn % 32u);
+}
+
+static void irq_disable(uint32_t irqn)
+{
+    NVIC_ICER(irqn / 32u) = irq_bit(irqn);
+    arch_dsb();
+    arch_isb();
+}
+
+int runtime_irq_set_priority(uint32_t irqn, uint32_t prio)
+{
+    if ((irqn >= MCU_IRQ_COUNT) || (prio >= RUNTIME_IRQ_PRIO_LEVELS)) {
+        return -1;
+    }
+
+    NVIC_IPR(irqn) = (uint8_t)runtime_irq_prio_encode(prio);
+    return 0;
+}
+
+uint32_t runtime_irq_priority(uint32_t irqn)
+{
+    return (uint32_t)NVIC_IPR(irqn) >> (8u - MCU_NVIC_PRIO_BITS);
+}
+
+void runtime_irq_pend(uint32_t irqn)
+{
+    NVIC_ISPR(irqn / 32u) = irq_bit(irqn);
+}
+
+void runtime_irq_set_systick_priority(uint32_t prio)
+{
+    uint32_t primask = arch_irq_save();
+    SCB_SHPR3 = (SCB_SHPR3 & ~(0xFFu << SCB_SHPR3_SYSTICK_SHIFT)) |
+                (runtime_irq_prio_encode(prio) << SCB_SHPR3_SYSTICK_SHIFT);
+    arch_irq_restore(primask);
+}
+
+int runtime_irq_attach(uint32_t irqn, runtime_irq_handler_t handler, uint32_t prio)
+{
+    if ((irqn >= MCU_IRQ_COUNT) || (prio >= RUNTIME_IRQ_PRIO_LEVELS)) {
+        return -1;
+    }
+
+    irq_disable(irqn);
+
+    __vectors_ram_start[VECTOR_IRQ0 + irqn] = (uint32_t)handler;
+    runtime_irq_set_priority(irqn, prio);
+
+    /* Table write must land before the NVIC can fetch the vector */
+    arch_dsb();
+
+    NVIC_ICPR(irqn / 32u) = irq_bit(irqn);
+    NVIC_ISER(irqn / 32u) = irq_bit(irqn);
+    return 0;
+}
+
+void runtime_irq_detach(uint32_t irqn)
+{
+    if (irqn >= MCU_IRQ_COUNT) {
+        return;
+    }
+
+    irq_disable(irqn);
+    __vectors_ram_start[VECTOR_IRQ0 + irqn] = g_pfnVectors[VECTOR_IRQ0 + irqn];
+    arch_dsb();
+}
+
+int runtime_irq_attach_exception(uint32_t exc, runtime_irq_handler_t handler)
+{
+    if ((exc < 2u) || (exc >= VECTOR_IRQ0)) {
+        return -1;
+    }
+
+    __vectors_ram_start[exc] = (uint32_t)handler;
+    arch_dsb();
+    return 0;
+}
@@ -0,0 +1,99 @@
+/* runtime_irq.h — interrupt registration, priorities and critical sections
+ *
+ * Reset_Handler copies the flash vector table (16 system entries plus every
+ * external IRQ of the MCU) into a RAM buffer and points VTOR at it. Handlers
+ * are written straight into that table: the NVIC branches to them with no
+ * dispatcher in between, so latency is the hardware's 12-cycle minimum.
+ *
+ * Priorities are logical levels 0 (most urgent) .. RUNTIME_IRQ_PRIO_LEVELS-1,
+ * shifted into the implemented top bits of each 8-bit NVIC field here.
+ */
+
+#ifndef RUNTIME_IRQ_H
+#define RUNTIME_IRQ_H
+
+#include <stdint.h>
+#include "mcu.h"
+#include "arch_cortexm_baremetal.h"
+
+#define RUNTIME_IRQ_PRIO_LEVELS  (1u << MCU_NVIC_PRIO_BITS)
+
+typedef void (*runtime_irq_handler_t)(void);
+
+/* Saved mask state returned by runtime_crit_enter*() */
+typedef uint32_t runtime_crit_t;
+
+/* Logical level -> 8-bit NVIC/SHPR/BASEPRI value */
+static inline uint32_t runtime_irq_prio_encode(uint32_t prio)
+{
+    return (prio << (8u - MCU_NVIC_PRIO_BITS)) & 0xFFu;
+}
+
+/* ---- critical sections ---- */
+
+/* Mask every interrupt. Nests: exit restores the state enter found, so
+ * an inner section never re-enables IRQs under an outer one.
+ *
+ *   runtime_crit_t c = runtime_crit_enter();
+ *   ...
+ *   runtime_crit_exit(c);
+ */
+static inline runtime_crit_t runtime_crit_enter(void)
+{
+    return arch_irq_save();
+}
+
+static inline void runtime_crit_exit(runtime_crit_t saved)
+{
+    arch_irq_restore(saved);
+}
+
+/* Mask only interrupts at logical level prio or less urgent
+ * (1 .. RUNTIME_IRQ_PRIO_LEVELS-1); more urgent handlers still preempt.
+ * Nests: an inner section never lowers the mask of an outer one.
+ * Unmasked handlers must not touch state the section protects, and
+ * SysTick (level 0 unless moved) stays live: runtime services keep
+ * using runtime_crit_enter().
+ */
+static inline runtime_crit_t runtime_crit_enter_prio(uint32_t prio)
+{
+    return arch_basepri_raise(runtime_irq_prio_encode(prio));
+}
+
+static inline void runtime_crit_exit_prio(runtime_crit_t saved)
+{
+    arch_basepri_restore(saved);
+}
+
+/* ---- handler registration ---- */
+
+/* Install handler for external IRQ irqn, set its priority and enable it.
+ * A stale pending request is discarded first.
+ * Returns 0, or -1 if irqn or prio is out of range.
+ */
+int runtime_irq_attach(uint32_t irqn, runtime_irq_handler_t handler, uint32_t prio);
+
+/* Disable irqn and put the boot (flash table) entry back */
+void runtime_irq_detach(uint32_t irqn);
+
+/* Point a system exception (2 = NMI .. 15 = SysTick) at handler in the RAM
+ * vector table. Its priority and enable stay as they are. Returns 0, or -1
+ * for an out-of-range exception number.
+ */
+int runtime_irq_attach_exception(uint32_t exc, runtime_irq_handler_t handler);
+
+/* ---- NVIC / system priorities ---- */
+
+/* Returns 0, or -1 if irqn or prio is out of range */
+int runtime_irq_set_priority(uint32_t irqn, uint32_t prio);
+
+/* Logical priority of irqn */
+uint32_t runtime_irq_priority(uint32_t irqn);
+
+/* Request irqn from software (tests, deferred work) */
+void runtime_irq_pend(uint32_t irqn);
+
+/* Move SysTick off level 0, so BASEPRI sections can mask the tick too */
+void runtime_irq_set_systick_priority(uint32_t prio);
+
+#endif /* RUNTIME_IRQ_H */
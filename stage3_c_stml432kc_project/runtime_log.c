@@ -0,0 +1,48 @@
+/* runtime_log.c — tokenized deferred logging */
+
+#include "runtime_log.h"
+#include "runtime_ring.h"
+#include "runtime_irq.h"
+
+/* Read by tools/log_decode.py from a RAM dump: keep the names */
+RUNTIME_RING_STORAGE(g_log_words, uint32_t, RUNTIME_LOG_WORDS);
+runtime_ring_t    g_log;
+volatile uint32_t g_log_dropped;
+
+void runtime_log_init(void)
+{
+    runtime_ring_init(&g_log, g_log_words, sizeof(uint32_t), RUNTIME_LOG_WORDS);
+    g_log_dropped = 0;
+}
+
+uint32_t runtime_log_dropped(void)
+{
+    return g_log_dropped;
+}
+
+uint32_t runtime_log_drain(uint32_t *dst, uint32_t max)
+{
+    return runtime_ring_pop_batch(&g_log, dst, max);
+}
+
+void runtime_log_write(const uint32_t *words, uint32_t count)
+{
+    /* Producers are any thread or ISR: serialize the few stores. The
+     * consumer (drain or debugger) stays lock-free on the other side.
+     */
+    runtime_crit_t crit = runtime_crit_enter();
+
+    if (runtime_ring_free(&g_log) < count) {
+        g_log_dropped++;
+    } else {
+        uint32_t *buf  = (uint32_t *)g_log.buf;
+        uint32_t  head = g_log.head;
+
+        for (uint32_t i = 0; i < count; i++) {
+            buf[(head + i) & g_log.mask] = words[i];
+        }
+        runtime_ring_commit(&g_log, count);
+    }
+
+    runtime_crit_exit(crit);
+}
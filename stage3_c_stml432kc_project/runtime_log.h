@@ -0,0 +1,93 @@
+/* runtime_log.h — tokenized deferred logging
+ *
+ * RUNTIME_LOG("fmt", args...) formats nothing on the target. The format
+ * string goes into .log_fmt, a non-loaded ELF section (linker.ld), and its
+ * address there is the token. At run time only the token and up to four
+ * 32-bit arguments are copied into a RAM ring of words.
+ *
+ * tools/log_decode.py rebuilds the text from build/blink.elf plus either a
+ * RAM dump (reads g_log directly) or a drained word stream:
+ *
+ *   (gdb) dump binary memory ram.bin 0x20000000 0x2000C000
+ *   $ python3 tools/log_decode.py build/blink.elf --dump ram.bin
+ *
+ * Arguments are integers, or pointers to strings that live in flash
+ * (decoded from the ELF with %s). Formats are type-checked like printf.
+ * Safe from any context; a full ring drops the record and counts it.
+ */
+
+#ifndef RUNTIME_LOG_H
+#define RUNTIME_LOG_H
+
+#include <stdint.h>
+
+/* Ring size in 32-bit words (power of two) */
+#ifndef RUNTIME_LOG_WORDS
+#define RUNTIME_LOG_WORDS  (256u)
+#endif
+
+#define RUNTIME_LOG_MAX_ARGS  (4u)
+
+void runtime_log_init(void);
+
+/* Records dropped because the ring was full */
+uint32_t runtime_log_dropped(void);
+
+/* Consumer side for a transport: copy out up to max whole words.
+ * Records are contiguous in the ring, so a drained stream decodes as is.
+ */
+uint32_t runtime_log_drain(uint32_t *dst, uint32_t max);
+
+/* Record writer behind RUNTIME_LOG; words[0] is the token */
+void runtime_log_write(const uint32_t *words, uint32_t count);
+
+/* printf-style checking of the call site, never executed */
+static inline __attribute__((format(printf, 1, 2)))
+void runtime_log_check(const char *fmt, ...)
+{
+    (void)fmt;
+}
+
+/* Argument counting in plain C11 (no ", ##__VA_ARGS__"): the format is
+ * always the first variadic argument, so the list is never empty.
+ */
+#define RUNTIME_LOG_COUNT_(_1, _2, _3, _4, _5, _6, n, ...)  n
+#define RUNTIME_LOG_COUNT(...) \
+    RUNTIME_LOG_COUNT_(__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define RUNTIME_LOG_FMT_(fmt, ...)  fmt
+#define RUNTIME_LOG_FMT(...)        RUNTIME_LOG_FMT_(__VA_ARGS__, 0)
+
+/* ", (uint32_t)(a), ..." for the 0..4 arguments after the format */
+#define RUNTIME_LOG_W1(f)
+#define RUNTIME_LOG_W2(f, a)          , (uint32_t)(a)
+#define RUNTIME_LOG_W3(f, a, b)       RUNTIME_LOG_W2(f, a) RUNTIME_LOG_W2(f, b)
+#define RUNTIME_LOG_W4(f, a, b, c)    RUNTIME_LOG_W3(f, a, b) RUNTIME_LOG_W2(f, c)
+#define RUNTIME_LOG_W5(f, a, b, c, d) RUNTIME_LOG_W4(f, a, b, c) RUNTIME_LOG_W2(f, d)
+#define RUNTIME_LOG_W6(...)           /* rejected by the _Static_assert */
+#define RUNTIME_LOG_CAT_(a, b)        a##b
+#define RUNTIME_LOG_CAT(a, b)         RUNTIME_LOG_CAT_(a, b)
+#define RUNTIME_LOG_ARGS(...) \
+    RUNTIME_LOG_CAT(RUNTIME_LOG_W, RUNTIME_LOG_COUNT(__VA_ARGS__))(__VA_ARGS__)
+
+/* Each call site gets its own format string in .log_fmt:
+ *
+ *   RUNTIME_LOG("tick %u, drift %d", ticks, drift);
+ */
+#define RUNTIME_LOG(...)                                                   \
+    do {                                                                   \
+        static const char runtime_log_fmt_[]                               \
+            __attribute__((section(".log_fmt"), used)) =                   \
+            RUNTIME_LOG_FMT(__VA_ARGS__);                                  \
+        _Static_assert(RUNTIME_LOG_COUNT(__VA_ARGS__) <=                   \
+                       1u + RUNTIME_LOG_MAX_ARGS,                          \
+                       "RUNTIME_LOG: at most 4 arguments");                \
+        if (0) {                                                           \
+            runtime_log_check(__VA_ARGS__);                                \
+        }                                                                  \
+        const uint32_t runtime_log_w_[] = {                                \
+            (uint32_t)runtime_log_fmt_ RUNTIME_LOG_ARGS(__VA_ARGS__)       \
+        };                                                                 \
+        runtime_log_write(runtime_log_w_, RUNTIME_LOG_COUNT(__VA_ARGS__)); \
+    } while (0)
+
+#endif /* RUNTIME_LOG_H */
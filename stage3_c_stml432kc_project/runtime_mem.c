@@ -0,0 +1,251 @@
+/* runtime_mem.c — memcpy / memset / memmove owned by the runtime
+ *
+ * Built with -fno-tree-loop-distribute-patterns (Makefile): otherwise GCC
+ * may turn the byte loops below back into calls to memcpy / memset,
+ * i.e. into themselves.
+ */
+
+#include <stdint.h>
+
+#include "runtime_mem.h"
+
+/* Word views that may alias any object; the unaligned one compiles to a
+ * plain LDR/STR on the M4 (unaligned access enabled)
+ */
+typedef uint32_t mem_word_t __attribute__((may_alias));
+typedef struct __attribute__((packed, may_alias)) {
+    uint32_t v;
+} mem_uword_t;
+
+#define MEM_BURST  (32u)
+
+static inline int mem_aligned(const void *p)
+{
+    return ((uintptr_t)p & 3u) == 0u;
+}
+
+/* ============================
+   32-byte bursts (word-aligned, blocks >= 1)
+   ============================ */
+#if defined(__thumb2__)
+
+static inline void burst_copy_fwd(uint8_t **d, const uint8_t **s, size_t blocks)
+{
+    __asm__ volatile ("1:\n\t"
+                      "ldmia %1!, {r3-r6}\n\t"
+                      "stmia %0!, {r3-r6}\n\t"
+                      "ldmia %1!, {r3-r6}\n\t"
+                      "stmia %0!, {r3-r6}\n\t"
+                      "subs  %2, %2, #1\n\t"
+                      "bne   1b"
+                      : "+r" (*d), "+r" (*s), "+r" (blocks)
+                      :
+                      : "r3", "r4", "r5", "r6", "cc", "memory");
+}
+
+/* Pointers at the end of the blocks, moving down */
+static inline void burst_copy_bwd(uint8_t **d, const uint8_t **s, size_t blocks)
+{
+    __asm__ volatile ("1:\n\t"
+                      "ldmdb %1!, {r3-r6}\n\t"
+                      "stmdb %0!, {r3-r6}\n\t"
+                      "ldmdb %1!, {r3-r6}\n\t"
+                      "stmdb %0!, {r3-r6}\n\t"
+                      "subs  %2, %2, #1\n\t"
+                      "bne   1b"
+                      : "+r" (*d), "+r" (*s), "+r" (blocks)
+                      :
+                      : "r3", "r4", "r5", "r6", "cc", "memory");
+}
+
+static inline void burst_fill(uint8_t **d, uint32_t word, size_t blocks)
+{
+    __asm__ volatile ("mov   r3, %2\n\t"
+                      "mov   r4, %2\n\t"
+                      "mov   r5, %2\n\t"
+                      "mov   r6, %2\n\t"
+                      "1:\n\t"
+                      "stmia %0!, {r3-r6}\n\t"
+                      "stmia %0!, {r3-r6}\n\t"
+                      "subs  %1, %1, #1\n\t"
+                      "bne   1b"
+                      : "+r" (*d), "+r" (blocks)
+                      : "r" (word)
+                      : "r3", "r4", "r5", "r6", "cc", "memory");
+}
+
+#else /* portable C (host builds) */
+
+static inline void burst_copy_fwd(uint8_t **d, const uint8_t **s, size_t blocks)
+{
+    mem_word_t       *dw = (mem_word_t *)*d;
+    const mem_word_t *sw = (const mem_word_t *)*s;
+
+    for (; blocks != 0u; blocks--, dw += 8, sw += 8) {
+        for (uint32_t i = 0; i < 8u; i++) {
+            dw[i] = sw[i];
+        }
+    }
+    *d = (uint8_t *)dw;
+    *s = (const uint8_t *)sw;
+}
+
+static inline void burst_copy_bwd(uint8_t **d, const uint8_t **s, size_t blocks)
+{
+    mem_word_t       *dw = (mem_word_t *)*d;
+    const mem_word_t *sw = (const mem_word_t *)*s;
+
+    for (; blocks != 0u; blocks--) {
+        dw -= 8;
+        sw -= 8;
+        for (uint32_t i = 8u; i-- != 0u; ) {
+            dw[i] = sw[i];
+        }
+    }
+    *d = (uint8_t *)dw;
+    *s = (const uint8_t *)sw;
+}
+
+static inline void burst_fill(uint8_t **d, uint32_t word, size_t blocks)
+{
+    mem_word_t *dw = (mem_word_t *)*d;
+
+    for (; blocks != 0u; blocks--, dw += 8) {
+        for (uint32_t i = 0; i < 8u; i++) {
+            dw[i] = word;
+        }
+    }
+    *d = (uint8_t *)dw;
+}
+
+#endif /* __thumb2__ */
+
+/* ============================
+   Copy
+   ============================ */
+
+/* Ascending addresses: also correct for overlap with dst below src, since
+ * every read happens before any write that could reach it
+ */
+static void copy_fwd(uint8_t *d, const uint8_t *s, size_t n)
+{
+    if (n >= RUNTIME_MEM_WORD_MIN) {
+        while (!mem_aligned(d)) {
+            *d++ = *s++;
+            n--;
+        }
+
+        if (mem_aligned(s)) {
+            if (n >= MEM_BURST) {
+                burst_copy_fwd(&d, &s, n / MEM_BURST);
+                n %= MEM_BURST;
+            }
+            for (; n >= 4u; n -= 4u, d += 4, s += 4) {
+                *(mem_word_t *)d = *(const mem_word_t *)s;
+            }
+        } else {
+            for (; n >= 4u; n -= 4u, d += 4, s += 4) {
+                *(mem_word_t *)d = ((const mem_uword_t *)s)->v;
+            }
+        }
+    }
+
+    while (n-- != 0u) {
+        *d++ = *s++;
+    }
+}
+
+/* Descending addresses, for dst above an overlapping src */
+static void copy_bwd(uint8_t *d, const uint8_t *s, size_t n)
+{
+    d += n;
+    s += n;
+
+    if (n >= RUNTIME_MEM_WORD_MIN) {
+        while (!mem_aligned(d)) {
+            *--d = *--s;
+            n--;
+        }
+
+        if (mem_aligned(s)) {
+            if (n >= MEM_BURST) {
+                burst_copy_bwd(&d, &s, n / MEM_BURST);
+                n %= MEM_BURST;
+            }
+            for (; n >= 4u; n -= 4u) {
+                d -= 4;
+                s -= 4;
+                *(mem_word_t *)d = *(const mem_word_t *)s;
+            }
+        } else {
+            for (; n >= 4u; n -= 4u) {
+                d -= 4;
+                s -= 4;
+                *(mem_word_t *)d = ((const mem_uword_t *)s)->v;
+            }
+        }
+    }
+
+    while (n-- != 0u) {
+        *--d = *--s;
+    }
+}
+
+void *runtime_memcpy(void *dst, const void *src, size_t n)
+{
+    copy_fwd((uint8_t *)dst, (const uint8_t *)src, n);
+    return dst;
+}
+
+void *runtime_memmove(void *dst, const void *src, size_t n)
+{
+    uint8_t       *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+
+    if (((uintptr_t)d - (uintptr_t)s) >= n) {
+        copy_fwd(d, s, n);      /* dst below src, or no overlap */
+    } else {
+        copy_bwd(d, s, n);
+    }
+    return dst;
+}
+
+/* ============================
+   Fill
+   ============================ */
+
+void *runtime_memset(void *dst, int c, size_t n)
+{
+    uint8_t *d = (uint8_t *)dst;
+    uint8_t  b = (uint8_t)c;
+
+    if (n >= RUNTIME_MEM_WORD_MIN) {
+        uint32_t word = b * 0x01010101u;
+
+        while (!mem_aligned(d)) {
+            *d++ = b;
+            n--;
+        }
+        if (n >= MEM_BURST) {
+            burst_fill(&d, word, n / MEM_BURST);
+            n %= MEM_BURST;
+        }
+        for (; n >= 4u; n -= 4u, d += 4) {
+            *(mem_word_t *)d = word;
+        }
+    }
+
+    while (n-- != 0u) {
+        *d++ = b;
+    }
+    return dst;
+}
+
+/* ============================
+   C library names
+   ============================ */
+#ifndef RUNTIME_MEM_NO_LIBC_NAMES
+void *memcpy(void *dst, const void *src, size_t n) __attribute__((alias("runtime_memcpy")));
+void *memset(void *dst, int c, size_t n) __attribute__((alias("runtime_memset")));
+void *memmove(void *dst, const void *src, size_t n) __attribute__((alias("runtime_memmove")));
+#endif
@@ -0,0 +1,34 @@
+/* runtime_mem.h — memcpy / memset / memmove owned by the runtime
+ *
+ * The build is freestanding and calls no C library function itself, yet
+ * GCC still emits calls to memcpy, memset and memmove for struct copies,
+ * large initialisers and recognised loops. runtime_mem.c defines those
+ * three symbols (aliases of the functions below), so every such call
+ * lands here instead of pulling the C library's versions in.
+ *
+ * Large blocks take a word path: the destination is aligned by a byte
+ * head, then 32-byte LDM/STM bursts when the source is word-aligned too
+ * (single unaligned LDRs otherwise), a word loop, and a byte tail. Short
+ * blocks stay on the byte loop, where the setup would not pay off.
+ *
+ * Normal memory only: the unaligned loads would fault on device memory.
+ *
+ * The same file builds on the host (`make mem-fuzz`), where
+ * tools/mem_fuzz.c checks it against the host C library.
+ */
+
+#ifndef RUNTIME_MEM_H
+#define RUNTIME_MEM_H
+
+#include <stddef.h>
+
+/* Blocks shorter than this are copied/filled bytewise */
+#define RUNTIME_MEM_WORD_MIN  (16u)
+
+void *runtime_memcpy(void *dst, const void *src, size_t n);
+void *runtime_memset(void *dst, int c, size_t n);
+
+/* Overlap-safe: copies forward when dst is below src, backward otherwise */
+void *runtime_memmove(void *dst, const void *src, size_t n);
+
+#endif /* RUNTIME_MEM_H */
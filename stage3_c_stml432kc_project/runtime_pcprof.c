@@ -0,0 +1,79 @@
+/* runtime_pcprof.c — statistical PC-sampling profiler */
+
+#include "runtime_pcprof.h"
+#include "runtime_irq.h"
+
+/* Exception frame: r0 r1 r2 r3 r12 lr pc xpsr */
+#define FRAME_PC  (6u)
+
+/* Read by tools/pcprof_report.py from a RAM dump: keep the name */
+runtime_pcprof_t g_pcprof;
+
+static runtime_pcprof_ack_fn s_ack;
+
+/* linker.ld */
+extern const uint8_t __text_start[];
+extern const uint8_t __text_end[];
+extern const uint8_t __ramfunc_start[];
+extern const uint8_t __ramfunc_end[];
+
+/* Smallest power-of-two bin (at least one halfword) that fits the range */
+static void range_init(runtime_pcprof_range_t *r, const uint8_t *base,
+                       const uint8_t *end, uint32_t bins)
+{
+    uint32_t span  = (uint32_t)(end - base);
+    uint32_t shift = 1u;
+
+    while (((span + (1u << shift) - 1u) >> shift) > bins) {
+        shift++;
+    }
+
+    r->base  = (uint32_t)base;
+    r->end   = (uint32_t)end;
+    r->shift = shift;
+}
+
+void runtime_pcprof_init(void)
+{
+    range_init(&g_pcprof.text, __text_start, __text_end, RUNTIME_PCPROF_TEXT_BINS);
+    range_init(&g_pcprof.ram, __ramfunc_start, __ramfunc_end, RUNTIME_PCPROF_RAM_BINS);
+    g_pcprof.samples = 0;
+    g_pcprof.other   = 0;
+    for (uint32_t i = 0; i < RUNTIME_PCPROF_TEXT_BINS + RUNTIME_PCPROF_RAM_BINS; i++) {
+        g_pcprof.hist[i] = 0;
+    }
+}
+
+void runtime_pcprof_record(const uint32_t *frame)
+{
+    uint32_t pc = frame[FRAME_PC];
+
+    g_pcprof.samples++;
+
+    /* Unsigned wrap makes each test a single compare */
+    if ((pc - g_pcprof.text.base) < (g_pcprof.text.end - g_pcprof.text.base)) {
+        g_pcprof.hist[(pc - g_pcprof.text.base) >> g_pcprof.text.shift]++;
+    } else if ((pc - g_pcprof.ram.base) < (g_pcprof.ram.end - g_pcprof.ram.base)) {
+        g_pcprof.hist[RUNTIME_PCPROF_TEXT_BINS +
+                      ((pc - g_pcprof.ram.base) >> g_pcprof.ram.shift)]++;
+    } else {
+        g_pcprof.other++;
+    }
+}
+
+void runtime_pcprof_start_systick(void)
+{
+    runtime_irq_attach_exception(15u, runtime_pcprof_systick_entry);
+}
+
+void runtime_pcprof_start_timer(runtime_pcprof_ack_fn ack)
+{
+    s_ack = ack;
+}
+
+void runtime_pcprof_timer_sample(const uint32_t *frame)
+{
+    /* Clear the flag first: it has time to land before exception return */
+    s_ack();
+    runtime_pcprof_record(frame);
+}
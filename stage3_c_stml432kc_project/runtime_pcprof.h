@@ -0,0 +1,76 @@
+/* runtime_pcprof.h — statistical PC-sampling profiler
+ *
+ * A periodic interrupt reads the PC that exception entry stacked for the
+ * code it interrupted and counts it in a histogram: one bin per 2^shift
+ * bytes of .text, plus a small one for .ramfunc. No code is instrumented;
+ * the result is a flat profile of whatever the firmware really does.
+ *
+ * Two sample sources (make PCPROF=systick | timer, see board.h):
+ *
+ *   systick : SysTick is routed through runtime_pcprof_systick_entry, which
+ *             samples, then runs SysTick_Handler. 1 kHz while busy, but the
+ *             tickless idle stretches the period, so idle is undersampled.
+ *   timer   : a dedicated timer interrupt at the most urgent priority, at
+ *             PCPROF_HZ. Uniform, and samples inside other handlers too.
+ *
+ * Code that runs with PRIMASK set cannot be sampled; its time shows up at
+ * the instruction that re-enables interrupts.
+ *
+ *   (gdb) dump binary memory ram.bin 0x20000000 0x2000C000
+ *   $ python3 tools/pcprof_report.py build/blink.elf --dump ram.bin
+ */
+
+#ifndef RUNTIME_PCPROF_H
+#define RUNTIME_PCPROF_H
+
+#include <stdint.h>
+
+#define RUNTIME_PCPROF_TEXT_BINS  (1024u)
+#define RUNTIME_PCPROF_RAM_BINS   (64u)
+
+/* Sample sources (RUNTIME_PCPROF, from the Makefile) */
+#define RUNTIME_PCPROF_SRC_SYSTICK  (1u)
+#define RUNTIME_PCPROF_SRC_TIMER    (2u)
+
+/* One address range: bin = (pc - base) >> shift */
+typedef struct {
+    uint32_t base;
+    uint32_t end;
+    uint32_t shift;
+} runtime_pcprof_range_t;
+
+typedef struct {
+    runtime_pcprof_range_t text;    /* hist[0 .. TEXT_BINS) */
+    runtime_pcprof_range_t ram;     /* hist[TEXT_BINS .. TEXT_BINS + RAM_BINS) */
+    uint32_t samples;               /* every sample taken */
+    uint32_t other;                 /* PC in neither range */
+    uint32_t hist[RUNTIME_PCPROF_TEXT_BINS + RUNTIME_PCPROF_RAM_BINS];
+} runtime_pcprof_t;
+
+extern runtime_pcprof_t g_pcprof;
+
+/* Clear the histogram and size the bins to .text and .ramfunc */
+void runtime_pcprof_init(void);
+
+/* Count one sample; frame is the hardware-stacked exception frame */
+void runtime_pcprof_record(const uint32_t *frame);
+
+/* Sample SysTick: install runtime_pcprof_systick_entry as its vector */
+void runtime_pcprof_start_systick(void);
+
+/* Sample a dedicated timer. ack clears its interrupt flag; attach
+ * runtime_pcprof_timer_entry to the timer IRQ afterwards.
+ */
+typedef void (*runtime_pcprof_ack_fn)(void);
+void runtime_pcprof_start_timer(runtime_pcprof_ack_fn ack);
+
+/* Called by runtime_pcprof_timer_entry: ack, then record */
+void runtime_pcprof_timer_sample(const uint32_t *frame);
+
+/* Exception entries (runtime_pcprof_entry.s): find the stacked frame
+ * from EXC_RETURN (MSP or PSP) and hand it over.
+ */
+void runtime_pcprof_systick_entry(void);
+void runtime_pcprof_timer_entry(void);
+
+#endif /* RUNTIME_PCPROF_H */
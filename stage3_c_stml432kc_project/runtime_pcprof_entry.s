@@ -0,0 +1,43 @@
+/* runtime_pcprof_entry.s — exception entries for runtime_pcprof.c
+ *
+ * Both find the hardware frame of the interrupted code: EXC_RETURN[2]
+ * (in lr) says whether it was stacked on MSP or PSP. The frame address
+ * goes to C in r0; lr must still hold EXC_RETURN when the last C function
+ * returns, so the C side ends the exception.
+ */
+
+.syntax unified
+.cpu cortex-m4
+.fpu fpv4-sp-d16
+.thumb
+
+.global runtime_pcprof_systick_entry
+.global runtime_pcprof_timer_entry
+
+/* SysTick vector while sampling: record, then the real tick handler */
+.section .text.runtime_pcprof_systick_entry,"ax",%progbits
+.type runtime_pcprof_systick_entry, %function
+.thumb_func
+runtime_pcprof_systick_entry:
+  tst   lr, #4
+  ite   eq
+  mrseq r0, msp
+  mrsne r0, psp
+  push  {r3, lr}              /* keep EXC_RETURN; r3 keeps 8-byte alignment */
+  bl    runtime_pcprof_record
+  pop   {r3, lr}
+  ldr   r0, =SysTick_Handler  /* may live in SRAM2: out of b.w range */
+  bx    r0
+.size runtime_pcprof_systick_entry, . - runtime_pcprof_systick_entry
+
+/* Dedicated sampling timer: tail-call straight into C */
+.section .text.runtime_pcprof_timer_entry,"ax",%progbits
+.type runtime_pcprof_timer_entry, %function
+.thumb_func
+runtime_pcprof_timer_entry:
+  tst   lr, #4
+  ite   eq
+  mrseq r0, msp
+  mrsne r0, psp
+  b     runtime_pcprof_timer_sample
+.size runtime_pcprof_timer_entry, . - runtime_pcprof_timer_entry
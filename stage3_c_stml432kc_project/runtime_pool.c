@@ -0,0 +1,150 @@
+/* runtime_pool.c — fixed-block pool allocator */
+
+#include "runtime_pool.h"
+
+#if defined(__thumb2__)
+#include "arch_cortexm_baremetal.h"
+#endif
+
+#define POOL_ALIGN  (8u)
+
+/* linker.ld */
+extern uint8_t __pool_arena_start[];
+extern uint8_t __pool_arena_end[];
+
+/* Next uncarved arena byte; moves only in runtime_pool_init() */
+static uint8_t *s_arena_next = __pool_arena_start;
+
+typedef struct pool_link {
+    struct pool_link *next;
+} pool_link_t;
+
+/* ============================
+   Free list head
+   ============================ */
+#if defined(__thumb2__)
+
+/* LDREX the head, read its link, STREX the link back: an exception
+ * anywhere in between (which may itself pop or push) fails the STREX.
+ */
+static void *list_pop(runtime_pool_t *pool)
+{
+    volatile uint32_t *head = (volatile uint32_t *)&pool->free;
+    pool_link_t       *blk;
+
+    do {
+        blk = (pool_link_t *)arch_ldrex(head);
+        if (blk == 0) {
+            arch_clrex();
+            return 0;
+        }
+    } while (arch_strex(head, (uint32_t)blk->next) != 0u);
+
+    return blk;
+}
+
+static void list_push(runtime_pool_t *pool, pool_link_t *blk)
+{
+    volatile uint32_t *head = (volatile uint32_t *)&pool->free;
+
+    do {
+        blk->next = (pool_link_t *)arch_ldrex(head);
+    } while (arch_strex(head, (uint32_t)blk) != 0u);
+}
+
+#else /* host builds: single-threaded */
+
+static void *list_pop(runtime_pool_t *pool)
+{
+    pool_link_t *blk = (pool_link_t *)pool->free;
+
+    if (blk != 0) {
+        pool->free = blk->next;
+    }
+    return blk;
+}
+
+static void list_push(runtime_pool_t *pool, pool_link_t *blk)
+{
+    blk->next  = (pool_link_t *)pool->free;
+    pool->free = blk;
+}
+
+#endif /* __thumb2__ */
+
+/* ============================
+   Pools
+   ============================ */
+
+int runtime_pool_init(runtime_pool_t *pool, const char *name,
+                      uint32_t block_size, uint32_t count)
+{
+    uint32_t size  = (block_size + POOL_ALIGN - 1u) & ~(POOL_ALIGN - 1u);
+    uint32_t avail = (uint32_t)(__pool_arena_end - s_arena_next);
+
+    if (size == 0u) {
+        size = POOL_ALIGN;
+    }
+
+    pool->name       = name;
+    pool->block_size = size;
+    pool->free       = 0;
+    pool->used       = 0;
+    pool->high_water = 0;
+    pool->failed     = 0;
+
+    if ((count == 0u) || (count > avail / size)) {
+        pool->base  = s_arena_next;
+        pool->end   = s_arena_next;
+        pool->count = 0;
+        return (count == 0u) ? 0 : -1;
+    }
+
+    pool->base    = s_arena_next;
+    pool->end     = s_arena_next + size * count;
+    pool->count   = count;
+    s_arena_next  = pool->end;
+
+    /* Link back to front, so blocks leave in address order */
+    for (uint32_t i = count; i-- != 0u; ) {
+        list_push(pool, (pool_link_t *)(pool->base + i * size));
+    }
+    return 0;
+}
+
+void *runtime_pool_alloc(runtime_pool_t *pool)
+{
+    void *blk = list_pop(pool);
+
+    if (blk == 0) {
+        __atomic_add_fetch(&pool->failed, 1u, __ATOMIC_RELAXED);
+        return 0;
+    }
+
+    uint32_t used = __atomic_add_fetch(&pool->used, 1u, __ATOMIC_RELAXED);
+    uint32_t high = __atomic_load_n(&pool->high_water, __ATOMIC_RELAXED);
+    while ((used > high) &&
+           !__atomic_compare_exchange_n(&pool->high_water, &high, used, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+    return blk;
+}
+
+int runtime_pool_free(runtime_pool_t *pool, void *blk)
+{
+    uint8_t *p = (uint8_t *)blk;
+
+    if ((p < pool->base) || (p >= pool->end) ||
+        ((uint32_t)(p - pool->base) % pool->block_size) != 0u) {
+        return -1;
+    }
+
+    __atomic_sub_fetch(&pool->used, 1u, __ATOMIC_RELAXED);
+    list_push(pool, (pool_link_t *)p);
+    return 0;
+}
+
+uint32_t runtime_pool_arena_free(void)
+{
+    return (uint32_t)(__pool_arena_end - s_arena_next);
+}
@@ -0,0 +1,64 @@
+/* runtime_pool.h — fixed-block pool allocator
+ *
+ * linker.ld reserves one arena (_pool_size bytes after .bss);
+ * runtime_pool_init() carves a pool of `count` equal blocks out of it at
+ * start-up. There is no general heap and nothing is ever returned to the
+ * arena, so there is no fragmentation: a block is either on its pool's
+ * free list or owned by someone.
+ *
+ * - alloc and free are O(1): pop / push on an intrusive singly linked
+ *   free list (the link lives in the free block itself)
+ * - lock-free and IRQ-safe on the M4: the list head is updated with
+ *   LDREX/STREX, which any exception in between makes retry, so an ISR
+ *   and the thread may allocate and free from the same pool
+ * - occupancy, high-water mark and failed allocations are counted per
+ *   pool, for sizing `count` from a debugger:
+ *
+ *     (gdb) p my_pool
+ *
+ * Blocks are 8-byte aligned, and block sizes are rounded up to 8.
+ * The same file builds on the host (`make pool-bench`), single-threaded.
+ */
+
+#ifndef RUNTIME_POOL_H
+#define RUNTIME_POOL_H
+
+#include <stdint.h>
+
+typedef struct {
+    const char *name;           /* for the debugger */
+    uint8_t    *base;           /* first block */
+    uint8_t    *end;            /* one past the last block */
+    uint32_t    block_size;     /* bytes, multiple of 8 */
+    uint32_t    count;          /* blocks in the pool */
+    void       *free;           /* free list head (link in the block's first word) */
+    uint32_t    used;           /* blocks handed out now */
+    uint32_t    high_water;     /* most blocks ever handed out at once */
+    uint32_t    failed;         /* allocs that found the pool empty */
+} runtime_pool_t;
+
+/* Carve count blocks of block_size bytes from the arena. Returns 0, or
+ * -1 when the arena has no room left (the pool then stays empty).
+ * Thread context, before the pool is shared.
+ */
+int runtime_pool_init(runtime_pool_t *pool, const char *name,
+                      uint32_t block_size, uint32_t count);
+
+/* A free block, or NULL when the pool is exhausted. Never blocks. */
+void *runtime_pool_alloc(runtime_pool_t *pool);
+
+/* Return a block to its pool. Returns -1 (and changes nothing) when blk
+ * is not the start of a block of this pool. Double frees are not detected.
+ */
+int runtime_pool_free(runtime_pool_t *pool, void *blk);
+
+/* Arena bytes not yet carved into pools */
+uint32_t runtime_pool_arena_free(void);
+
+/* Typed use: one pool per object type */
+#define RUNTIME_POOL_INIT(pool, type, count) \
+    runtime_pool_init((pool), #type, (uint32_t)sizeof(type), (count))
+
+#define RUNTIME_POOL_ALLOC(pool, type)  ((type *)runtime_pool_alloc(pool))
+
+#endif /* RUNTIME_POOL_H */
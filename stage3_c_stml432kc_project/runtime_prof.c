@@ -0,0 +1,81 @@
+/* runtime_prof.c — DWT cycle-counter profiling probes */
+
+#include <stddef.h>
+#include "runtime_prof.h"
+
+runtime_prof_probe_t  g_prof[RUNTIME_PROF_PROBES];
+uint32_t              g_prof_used;
+runtime_boot_cycles_t g_boot_cycles;
+
+/* Cost of two back-to-back CYCCNT reads, taken off every measurement */
+static uint32_t s_overhead;
+
+uint32_t runtime_prof_register(const char *name)
+{
+    uint32_t primask = arch_irq_save();
+    uint32_t id;
+
+    if (g_prof_used == 0u) {
+        uint32_t t0 = arch_cyccnt();
+        uint32_t t1 = arch_cyccnt();
+        s_overhead = t1 - t0;
+    }
+
+    for (id = 0; id < g_prof_used; id++) {
+        if (g_prof[id].name == name) {
+            arch_irq_restore(primask);
+            return id;
+        }
+    }
+
+    if (g_prof_used == RUNTIME_PROF_PROBES) {
+        arch_irq_restore(primask);
+        return RUNTIME_PROF_UNREGISTERED;
+    }
+
+    id = g_prof_used++;
+    g_prof[id].name  = name;
+    g_prof[id].count = 0;
+    g_prof[id].last  = 0;
+    g_prof[id].min   = UINT32_MAX;
+    g_prof[id].max   = 0;
+    g_prof[id].sum   = 0;
+
+    arch_irq_restore(primask);
+    return id;
+}
+
+void runtime_prof_record(uint32_t id, uint32_t cycles)
+{
+    if (id >= g_prof_used) {
+        return;
+    }
+
+    cycles = (cycles > s_overhead) ? (cycles - s_overhead) : 0u;
+
+    uint32_t primask = arch_irq_save();
+    runtime_prof_probe_t *p = &g_prof[id];
+
+    p->count++;
+    p->last = cycles;
+    p->sum += cycles;
+    if (cycles < p->min) {
+        p->min = cycles;
+    }
+    if (cycles > p->max) {
+        p->max = cycles;
+    }
+    arch_irq_restore(primask);
+}
+
+void runtime_prof_end(uint32_t id, uint32_t t0)
+{
+    runtime_prof_record(id, arch_cyccnt() - t0);
+}
+
+void runtime_prof_boot_phases(void)
+{
+    /* Bracketed by CYCCNT reads in startup.s, same overhead as a probe */
+    runtime_prof_record(runtime_prof_register("reset_copy_table"), g_boot_cycles.copy_table);
+    runtime_prof_record(runtime_prof_register("reset_zero_table"), g_boot_cycles.zero_table);
+}
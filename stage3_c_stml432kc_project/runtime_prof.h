@@ -0,0 +1,81 @@
+/* runtime_prof.h — DWT cycle-counter profiling probes
+ *
+ * Named probes accumulate count / last / min / max / sum (mean = sum/count)
+ * in a RAM table, g_prof[], meant to be read from the debugger:
+ *
+ *   (gdb) p g_prof_used
+ *   (gdb) p g_prof[0]@g_prof_used
+ *
+ * Cycles come from DWT CYCCNT, which startup.s already runs from reset.
+ * Begin/end overhead is measured once and subtracted.
+ */
+
+#ifndef RUNTIME_PROF_H
+#define RUNTIME_PROF_H
+
+#include <stdint.h>
+#include "arch_cortexm_baremetal.h"
+
+#define RUNTIME_PROF_PROBES       (16u)
+#define RUNTIME_PROF_UNREGISTERED (0xFFFFFFFFu)
+
+typedef struct {
+    const char *name;
+    uint32_t    count;
+    uint32_t    last;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    sum;
+} runtime_prof_probe_t;
+
+extern runtime_prof_probe_t g_prof[RUNTIME_PROF_PROBES];
+extern uint32_t             g_prof_used;
+
+/* Reset_Handler phase costs, written by startup.s after .bss is cleared */
+typedef struct {
+    uint32_t copy_table;  /* every copy-table region (.data, ...) */
+    uint32_t zero_table;  /* every zero-table region (.bss, ...) */
+} runtime_boot_cycles_t;
+
+extern runtime_boot_cycles_t g_boot_cycles;
+
+/* Find or create the probe for name (compared by pointer, so pass a string
+ * literal). Returns its id, or RUNTIME_PROF_UNREGISTERED if the table is full.
+ */
+uint32_t runtime_prof_register(const char *name);
+
+/* Fold one measurement into a probe */
+void runtime_prof_record(uint32_t id, uint32_t cycles);
+
+/* Record the Reset_Handler phases from g_boot_cycles as probes */
+void runtime_prof_boot_phases(void);
+
+static inline uint32_t runtime_prof_begin(void)
+{
+    return arch_cyccnt();
+}
+
+/* Close a measurement started with runtime_prof_begin() */
+void runtime_prof_end(uint32_t id, uint32_t t0);
+
+/* Scoped measurement, registered on first use:
+ *
+ *   RUNTIME_PROF_BEGIN(init_clock);
+ *   init_clock();
+ *   RUNTIME_PROF_END(init_clock);
+ */
+#define RUNTIME_PROF_BEGIN(tag)                                           \
+    static uint32_t tag##_prof_id = RUNTIME_PROF_UNREGISTERED;            \
+    uint32_t tag##_prof_t0 = runtime_prof_begin()
+
+#define RUNTIME_PROF_END(tag)                                             \
+    do {                                                                  \
+        uint32_t tag##_prof_t1 = runtime_prof_begin();                    \
+        if (tag##_prof_id == RUNTIME_PROF_UNREGISTERED) {                 \
+            tag##_prof_id = runtime_prof_register(#tag);                  \
+        }                                                                 \
+        runtime_prof_record(tag##_prof_id,                                \
+                            tag##_prof_t1 - tag##_prof_t0);               \
+    } while (0)
+
+#endif /* RUNTIME_PROF_H */
@@ -0,0 +1,193 @@
+/* runtime_ring.h — lock-free single-producer / single-consumer ring
+ *
+ * Moves fixed-size elements from one context to another (typically ISR to
+ * thread) without masking interrupts. Exactly one producer and one consumer;
+ * either may be an ISR.
+ *
+ * - Capacity is a power of two; head/tail are free-running counters, so a
+ *   full ring holds all `capacity` elements.
+ * - head is written only by the producer, tail only by the consumer.
+ *   Acquire/release on those two words orders the element data
+ *   (DMB on Cortex-M4; the same code builds on a host compiler).
+ * - reserve/commit and peek/release expose contiguous spans for zero-copy
+ *   use (e.g. a DMA or parser working in place).
+ *
+ * Header-only. No allocation: storage is supplied by the caller.
+ */
+
+#ifndef RUNTIME_RING_H
+#define RUNTIME_RING_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint8_t  *buf;
+    uint32_t  elem_size;   /* bytes per element */
+    uint32_t  mask;        /* capacity - 1 */
+    uint32_t  head;        /* next slot to write (producer-owned) */
+    uint32_t  tail;        /* next slot to read  (consumer-owned) */
+} runtime_ring_t;
+
+/* Static storage for `capacity` elements of `type` (capacity: power of two) */
+#define RUNTIME_RING_STORAGE(name, type, capacity)                          \
+    _Static_assert(((capacity) & ((capacity) - 1u)) == 0u,                  \
+                   #name ": ring capacity must be a power of two");         \
+    static type name[capacity]
+
+static inline uint32_t ring_load_acquire(const uint32_t *p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void ring_store_release(uint32_t *p, uint32_t v)
+{
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+static inline void ring_copy(uint8_t *dst, const uint8_t *src, uint32_t n)
+{
+    while (n--) {
+        *dst++ = *src++;
+    }
+}
+
+static inline void runtime_ring_init(runtime_ring_t *r, void *storage,
+                                     uint32_t elem_size, uint32_t capacity)
+{
+    r->buf       = (uint8_t *)storage;
+    r->elem_size = elem_size;
+    r->mask      = capacity - 1u;
+    r->head      = 0;
+    r->tail      = 0;
+}
+
+static inline uint32_t runtime_ring_capacity(const runtime_ring_t *r)
+{
+    return r->mask + 1u;
+}
+
+/* ---- producer side ---- */
+
+static inline uint32_t runtime_ring_free(const runtime_ring_t *r)
+{
+    return runtime_ring_capacity(r) - (r->head - ring_load_acquire(&r->tail));
+}
+
+/* Contiguous writable span of up to `want` elements.
+ * Returns its address and stores the granted length (0 if full); the span
+ * may be shorter than the free space when it would cross the wrap point.
+ * Nothing is visible to the consumer until runtime_ring_commit().
+ */
+static inline void *runtime_ring_reserve(runtime_ring_t *r, uint32_t want, uint32_t *granted)
+{
+    uint32_t head  = r->head;
+    uint32_t free  = runtime_ring_free(r);
+    uint32_t index = head & r->mask;
+    uint32_t run   = runtime_ring_capacity(r) - index;
+
+    if (want > free) {
+        want = free;
+    }
+    if (want > run) {
+        want = run;
+    }
+
+    *granted = want;
+    return r->buf + index * r->elem_size;
+}
+
+/* Publish n elements written into the last reserved span */
+static inline void runtime_ring_commit(runtime_ring_t *r, uint32_t n)
+{
+    ring_store_release(&r->head, r->head + n);
+}
+
+/* Copy one element in. Returns 1, or 0 if the ring is full. */
+static inline int runtime_ring_push(runtime_ring_t *r, const void *elem)
+{
+    uint32_t granted;
+    void    *slot = runtime_ring_reserve(r, 1u, &granted);
+
+    if (granted == 0u) {
+        return 0;
+    }
+    ring_copy((uint8_t *)slot, (const uint8_t *)elem, r->elem_size);
+    runtime_ring_commit(r, 1u);
+    return 1;
+}
+
+/* ---- consumer side ---- */
+
+static inline uint32_t runtime_ring_count(const runtime_ring_t *r)
+{
+    return ring_load_acquire(&r->head) - r->tail;
+}
+
+/* Contiguous readable span; stores its length in *avail (0 if empty).
+ * Elements stay owned by the ring until runtime_ring_release().
+ */
+static inline const void *runtime_ring_peek(runtime_ring_t *r, uint32_t *avail)
+{
+    uint32_t tail  = r->tail;
+    uint32_t count = runtime_ring_count(r);
+    uint32_t index = tail & r->mask;
+    uint32_t run   = runtime_ring_capacity(r) - index;
+
+    *avail = (count < run) ? count : run;
+    return r->buf + index * r->elem_size;
+}
+
+/* Hand n consumed elements back to the producer */
+static inline void runtime_ring_release(runtime_ring_t *r, uint32_t n)
+{
+    ring_store_release(&r->tail, r->tail + n);
+}
+
+/* Copy one element out. Returns 1, or 0 if the ring is empty. */
+static inline int runtime_ring_pop(runtime_ring_t *r, void *elem)
+{
+    uint32_t    avail;
+    const void *slot = runtime_ring_peek(r, &avail);
+
+    if (avail == 0u) {
+        return 0;
+    }
+    ring_copy((uint8_t *)elem, (const uint8_t *)slot, r->elem_size);
+    runtime_ring_release(r, 1u);
+    return 1;
+}
+
+/* Copy out up to max elements (across the wrap point) with a single
+ * release. Returns the number of elements copied.
+ */
+static inline uint32_t runtime_ring_pop_batch(runtime_ring_t *r, void *dst, uint32_t max)
+{
+    uint8_t  *out   = (uint8_t *)dst;
+    uint32_t  count = runtime_ring_count(r);
+    uint32_t  tail  = r->tail;
+    uint32_t  total = 0;
+
+    if (max > count) {
+        max = count;
+    }
+
+    /* At most two spans: up to the wrap point, then from slot 0 */
+    while (total < max) {
+        uint32_t index = (tail + total) & r->mask;
+        uint32_t run   = runtime_ring_capacity(r) - index;
+        uint32_t n     = max - total;
+        if (n > run) {
+            n = run;
+        }
+        ring_copy(out, r->buf + index * r->elem_size, n * r->elem_size);
+        out   += n * r->elem_size;
+        total += n;
+    }
+
+    if (total != 0u) {
+        runtime_ring_release(r, total);
+    }
+    return total;
+}
+
+#endif /* RUNTIME_RING_H */
@@ -0,0 +1,164 @@
+/* runtime_rtt.c — debugger-visible ring buffers (RTT-style transport) */
+
+#include "runtime_rtt.h"
+#include "runtime_log.h"
+#include "runtime_irq.h"
+#include "runtime_mem.h"
+
+runtime_rtt_cb_t g_rtt;
+
+static uint8_t s_terminal[RUNTIME_RTT_TERMINAL_BYTES];
+static uint8_t s_log[RUNTIME_RTT_LOG_BYTES];
+static uint8_t s_down[RUNTIME_RTT_DOWN_BYTES];
+
+/* The probe is the other side of every index: order data against them */
+static inline uint32_t rtt_load_acquire(const volatile uint32_t *p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void rtt_store_release(volatile uint32_t *p, uint32_t v)
+{
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+static void rtt_buffer_init(runtime_rtt_buffer_t *b, const char *name,
+                            uint8_t *buf, uint32_t size, uint32_t flags)
+{
+    b->name  = name;
+    b->buf   = buf;
+    b->size  = size;
+    b->wr    = 0;
+    b->rd    = 0;
+    b->flags = flags;
+}
+
+void runtime_rtt_init(void)
+{
+    static const char id[] = RUNTIME_RTT_ID;
+
+    g_rtt.max_up   = RUNTIME_RTT_UP_CHANNELS;
+    g_rtt.max_down = RUNTIME_RTT_DOWN_CHANNELS;
+    rtt_buffer_init(&g_rtt.up[RUNTIME_RTT_CH_TERMINAL], "Terminal",
+                    s_terminal, sizeof s_terminal, RUNTIME_RTT_MODE_TRIM);
+    rtt_buffer_init(&g_rtt.up[RUNTIME_RTT_CH_LOG], "Log",
+                    s_log, sizeof s_log, RUNTIME_RTT_MODE_SKIP);
+    rtt_buffer_init(&g_rtt.down[0], "Terminal",
+                    s_down, sizeof s_down, RUNTIME_RTT_MODE_SKIP);
+
+    /* Id last, first byte last: a matching scan means a complete block */
+    for (uint32_t i = sizeof id - 1u; i > 0u; i--) {
+        g_rtt.id[i] = id[i];
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    g_rtt.id[0] = id[0];
+}
+
+static uint32_t rtt_space(const runtime_rtt_buffer_t *b)
+{
+    uint32_t rd = rtt_load_acquire(&b->rd);
+    uint32_t wr = b->wr;
+
+    return (rd > wr) ? (rd - wr - 1u) : (b->size - 1u - (wr - rd));
+}
+
+uint32_t runtime_rtt_space(uint32_t chan)
+{
+    if (chan >= RUNTIME_RTT_UP_CHANNELS) {
+        return 0;
+    }
+    return rtt_space(&g_rtt.up[chan]);
+}
+
+static uint32_t rtt_write(runtime_rtt_buffer_t *b, const void *data, uint32_t len)
+{
+    const uint8_t *src  = (const uint8_t *)data;
+    runtime_crit_t crit = runtime_crit_enter();
+    uint32_t       free = rtt_space(b);
+
+    if (len > free) {
+        len = (b->flags == RUNTIME_RTT_MODE_TRIM) ? free : 0u;
+    }
+
+    /* At most two spans: up to the end of the buffer, then from its start */
+    uint32_t wr    = b->wr;
+    uint32_t first = b->size - wr;
+
+    if (first > len) {
+        first = len;
+    }
+    runtime_memcpy(&b->buf[wr], src, first);
+    runtime_memcpy(&b->buf[0], src + first, len - first);
+    wr += len;
+    if (wr >= b->size) {
+        wr -= b->size;
+    }
+    rtt_store_release(&b->wr, wr);
+
+    runtime_crit_exit(crit);
+    return len;
+}
+
+uint32_t runtime_rtt_write(uint32_t chan, const void *data, uint32_t len)
+{
+    /* Channel 1 belongs to runtime_rtt_pump_log() */
+    if ((chan >= RUNTIME_RTT_UP_CHANNELS) || (chan == RUNTIME_RTT_CH_LOG)) {
+        return 0;
+    }
+    return rtt_write(&g_rtt.up[chan], data, len);
+}
+
+uint32_t runtime_rtt_puts(const char *s)
+{
+    uint32_t len = 0;
+
+    while (s[len] != '\0') {
+        len++;
+    }
+    return runtime_rtt_write(RUNTIME_RTT_CH_TERMINAL, s, len);
+}
+
+uint32_t runtime_rtt_read(uint32_t chan, void *dst, uint32_t max)
+{
+    uint8_t *out = (uint8_t *)dst;
+
+    if (chan >= RUNTIME_RTT_DOWN_CHANNELS) {
+        return 0;
+    }
+
+    runtime_rtt_buffer_t *b  = &g_rtt.down[chan];
+    uint32_t              wr = rtt_load_acquire(&b->wr);
+    uint32_t              rd = b->rd;
+    uint32_t              n  = 0;
+
+    while (n < max && rd != wr) {
+        out[n++] = b->buf[rd];
+        if (++rd == b->size) {
+            rd = 0;
+        }
+    }
+    rtt_store_release(&b->rd, rd);
+    return n;
+}
+
+void runtime_rtt_pump_log(void)
+{
+    runtime_rtt_buffer_t *b = &g_rtt.up[RUNTIME_RTT_CH_LOG];
+    uint32_t              words[32];
+
+    for (;;) {
+        uint32_t room = rtt_space(b) / sizeof(uint32_t);
+        if (room > 32u) {
+            room = 32u;
+        }
+
+        /* runtime_rtt_write() refuses channel 1, so only this loop writes
+         * it and the room cannot shrink before the write
+         */
+        uint32_t n = runtime_log_drain(words, room);
+        if (n == 0u) {
+            return;
+        }
+        rtt_write(b, words, n * sizeof(uint32_t));
+    }
+}
@@ -0,0 +1,91 @@
+/* runtime_rtt.h — debugger-visible ring buffers (RTT-style transport)
+ *
+ * A control block in RAM, g_rtt, starts with the id string "SEGGER RTT"
+ * and describes up (target -> host) and down (host -> target) byte rings.
+ * The probe finds it by scanning RAM for the id (or by the ELF symbol) and
+ * moves data with plain memory reads and writes while the core runs: no
+ * halt, no UART, and a write costs one copy into RAM.
+ *
+ * Layout and index rules are SEGGER's, so both readers work:
+ *
+ *   $ python3 tools/rtt_read.py --elf build/blink.elf      (OpenOCD TCL port)
+ *   > rtt setup 0x20000000 0xC000 "SEGGER RTT"            (OpenOCD built-in)
+ *
+ * Each ring has one slot kept empty; wr is advanced only by the writer and
+ * rd only by the reader. Channels:
+ *
+ *   up 0   : text terminal (runtime_rtt_write / runtime_rtt_puts)
+ *   up 1   : runtime_log word stream (runtime_rtt_pump_log)
+ *   down 0 : host input (runtime_rtt_read)
+ */
+
+#ifndef RUNTIME_RTT_H
+#define RUNTIME_RTT_H
+
+#include <stdint.h>
+
+#define RUNTIME_RTT_ID            "SEGGER RTT"
+#define RUNTIME_RTT_UP_CHANNELS   (2u)
+#define RUNTIME_RTT_DOWN_CHANNELS (1u)
+
+#define RUNTIME_RTT_CH_TERMINAL   (0u)
+#define RUNTIME_RTT_CH_LOG        (1u)
+
+#ifndef RUNTIME_RTT_TERMINAL_BYTES
+#define RUNTIME_RTT_TERMINAL_BYTES (512u)
+#endif
+#ifndef RUNTIME_RTT_LOG_BYTES
+#define RUNTIME_RTT_LOG_BYTES      (1024u)
+#endif
+#ifndef RUNTIME_RTT_DOWN_BYTES
+#define RUNTIME_RTT_DOWN_BYTES     (32u)
+#endif
+
+/* What a write does when the ring cannot take all of it (flags field) */
+#define RUNTIME_RTT_MODE_SKIP     (0u)  /* drop the whole write */
+#define RUNTIME_RTT_MODE_TRIM     (1u)  /* write what fits */
+
+typedef struct {
+    const char        *name;
+    uint8_t           *buf;
+    uint32_t           size;
+    volatile uint32_t  wr;     /* next byte to write, 0 .. size-1 */
+    volatile uint32_t  rd;     /* next byte to read,  0 .. size-1 */
+    uint32_t           flags;
+} runtime_rtt_buffer_t;
+
+typedef struct {
+    char                 id[16];
+    int32_t              max_up;
+    int32_t              max_down;
+    runtime_rtt_buffer_t up[RUNTIME_RTT_UP_CHANNELS];
+    runtime_rtt_buffer_t down[RUNTIME_RTT_DOWN_CHANNELS];
+} runtime_rtt_cb_t;
+
+extern runtime_rtt_cb_t g_rtt;
+
+/* Set up the rings, then publish the id so a scan never sees half a block */
+void runtime_rtt_init(void);
+
+/* Copy len bytes to an up channel; returns the bytes written (0 when a
+ * SKIP-mode channel is short of space). Safe from any context. Channel 1
+ * is refused (returns 0): only runtime_rtt_pump_log() writes it, so a
+ * record is never cut short.
+ */
+uint32_t runtime_rtt_write(uint32_t chan, const void *data, uint32_t len);
+
+uint32_t runtime_rtt_puts(const char *s);
+
+/* Free bytes in an up channel */
+uint32_t runtime_rtt_space(uint32_t chan);
+
+/* Copy up to max bytes from a down channel; returns the count */
+uint32_t runtime_rtt_read(uint32_t chan, void *dst, uint32_t max);
+
+/* Move whole words from the runtime_log ring into up channel 1, as many as
+ * fit. Call from one context only, the idle loop;
+ * tools/log_decode.py --stream decodes it.
+ */
+void runtime_rtt_pump_log(void);
+
+#endif /* RUNTIME_RTT_H */
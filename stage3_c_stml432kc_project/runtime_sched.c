@@ -0,0 +1,186 @@
+/* runtime_sched.c — fixed-priority preemptive task scheduler */
+
+#include <stddef.h>
+#include "runtime.h"
+#include "runtime_sched.h"
+#include "runtime_stack.h"
+#include "arch_cortexm_baremetal.h"
+
+/* EXC_RETURN for a fresh task: thread mode, PSP, basic (no FP) frame */
+#define EXC_RETURN_THREAD_PSP  (0xFFFFFFFDu)
+#define XPSR_THUMB             (1u << 24)
+
+/* Read by PendSV_Handler (runtime_sched_switch.s) */
+runtime_task_t *volatile g_sched_current;
+runtime_task_t *volatile g_sched_next;
+
+static runtime_task_t *s_task[RUNTIME_SCHED_PRIO_IDLE + 1u];
+
+/* Bit (31 - prio) set when that task is ready; CLZ yields the prio */
+static volatile uint32_t s_ready;
+
+static runtime_task_t s_idle_task;
+RUNTIME_TASK_STACK(s_idle_stack, 512u);
+
+static inline uint32_t prio_bit(uint32_t prio)
+{
+    return 0x80000000u >> prio;
+}
+
+/* Pick the highest ready task; pend PendSV if it is not the one running.
+ * Call with IRQs masked.
+ */
+static void sched_reschedule(void)
+{
+    runtime_task_t *best = s_task[__builtin_clz(s_ready)];
+
+    g_sched_next = best;
+    if (best != g_sched_current) {
+        SCB_ICSR = SCB_ICSR_PENDSVSET;
+    }
+}
+
+static void task_exit(void)
+{
+    /* A task returned from its entry: park it for good */
+    for (;;) {
+        runtime_sched_block();
+    }
+}
+
+/* Stretches SysTick while every task is blocked. A task woken from an
+ * ISR that goes back to sleep arms its timer inside that stretch;
+ * runtime_timer_start() pulls the wrap back to the deadline, so the sleep
+ * does not run on to the stretch end (covered by make tickless-sim).
+ */
+static void idle_entry(void *arg)
+{
+    for (;;) {
+        runtime_idle();
+    }
+}
+
+static void sleep_expired(runtime_timer_t *timer, void *arg)
+{
+    runtime_sched_wake((runtime_task_t *)arg);
+}
+
+/* Build the task's initial frame and make it ready. prio is free and in
+ * range: checked by runtime_sched_add(), fixed for the idle task.
+ */
+static void sched_add(runtime_task_t *task, runtime_task_fn entry, void *arg,
+                      uint64_t *stack, uint32_t stack_bytes, uint32_t prio)
+{
+    runtime_stack_paint(stack, stack_bytes);
+
+    /* Initial frame, as if PendSV had switched this task out:
+     * software-saved r4-r11 + EXC_RETURN, then the hardware frame.
+     */
+    uint32_t *sp = (uint32_t *)stack + (stack_bytes / 4u);
+
+    *--sp = XPSR_THUMB;                        /* xPSR */
+    *--sp = (uint32_t)entry & ~1u;             /* PC   */
+    *--sp = (uint32_t)task_exit;               /* LR   */
+    *--sp = 0;                                 /* R12  */
+    *--sp = 0;                                 /* R3   */
+    *--sp = 0;                                 /* R2   */
+    *--sp = 0;                                 /* R1   */
+    *--sp = (uint32_t)arg;                     /* R0   */
+    *--sp = EXC_RETURN_THREAD_PSP;             /* LR on exception entry */
+    for (uint32_t r = 4; r <= 11; r++) {
+        *--sp = 0;                             /* R11 .. R4 */
+    }
+
+    task->sp          = sp;
+    task->prio        = prio;
+    task->stack       = stack;
+    task->stack_bytes = stack_bytes;
+    runtime_timer_init(&task->sleep_timer, sleep_expired, task);
+
+    uint32_t primask = arch_irq_save();
+    s_task[prio] = task;
+    s_ready |= prio_bit(prio);
+    arch_irq_restore(primask);
+}
+
+int runtime_sched_add(runtime_task_t *task, runtime_task_fn entry, void *arg,
+                      uint64_t *stack, uint32_t stack_bytes, uint32_t prio)
+{
+    /* Level 31 is kept for the idle task */
+    if ((prio > RUNTIME_SCHED_PRIO_MAX) || (s_task[prio] != NULL)) {
+        return -1;
+    }
+
+    sched_add(task, entry, arg, stack, stack_bytes, prio);
+    return 0;
+}
+
+void runtime_sched_start(void)
+{
+    sched_add(&s_idle_task, idle_entry, NULL,
+              s_idle_stack, sizeof(s_idle_stack), RUNTIME_SCHED_PRIO_IDLE);
+
+    /* PendSV lowest, so switches only happen once every other handler is done */
+    SCB_SHPR3 |= (0xFFu << SCB_SHPR3_PENDSV_SHIFT);
+
+    arch_irq_disable();
+    g_sched_current = NULL;
+    sched_reschedule();
+    arch_irq_enable();
+
+    /* PendSV fires here and never returns to this context */
+    for (;;) { }
+}
+
+runtime_task_t *runtime_sched_current(void)
+{
+    return g_sched_current;
+}
+
+uint32_t runtime_sched_stack_used(const runtime_task_t *task)
+{
+    return runtime_stack_used(task->stack, task->stack_bytes);
+}
+
+void runtime_sched_sleep_ms(uint32_t ms)
+{
+    runtime_task_t *self = g_sched_current;
+
+    if (self == NULL) {
+        /* Before runtime_sched_start(): no task to park, just wait */
+        runtime_delay_ms(ms);
+        return;
+    }
+
+    uint32_t primask = arch_irq_save();
+    runtime_timer_start(&self->sleep_timer, ms, 0u);
+    s_ready &= ~prio_bit(self->prio);
+    sched_reschedule();
+    arch_irq_restore(primask);
+}
+
+void runtime_sched_block(void)
+{
+    runtime_task_t *self = g_sched_current;
+
+    if (self == NULL) {
+        /* Before runtime_sched_start(): nothing to block */
+        return;
+    }
+
+    uint32_t primask = arch_irq_save();
+    s_ready &= ~prio_bit(self->prio);
+    sched_reschedule();
+    arch_irq_restore(primask);
+}
+
+void runtime_sched_wake(runtime_task_t *task)
+{
+    uint32_t primask = arch_irq_save();
+    runtime_timer_cancel(&task->sleep_timer);
+    s_ready |= prio_bit(task->prio);
+    if (g_sched_current != NULL) {
+        sched_reschedule();
+    }
+    arch_irq_restore(primask);
+}
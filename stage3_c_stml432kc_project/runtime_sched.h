@@ -0,0 +1,67 @@
+/* runtime_sched.h — fixed-priority preemptive task scheduler
+ *
+ * One task per priority level, 0 (highest) .. 30. Level 31 is the idle
+ * task owned by the scheduler. The highest ready task always runs; the
+ * pick is a single CLZ on the ready bitmap.
+ *
+ * Context switches happen in PendSV (runtime_sched_switch.s), at the
+ * lowest exception priority, so they never delay another handler.
+ * Task stacks are caller-owned static arrays. No allocation.
+ */
+
+#ifndef RUNTIME_SCHED_H
+#define RUNTIME_SCHED_H
+
+#include <stdint.h>
+#include "runtime_timer.h"
+
+#define RUNTIME_SCHED_PRIO_MAX   (30u)
+#define RUNTIME_SCHED_PRIO_IDLE  (31u)
+
+/* Declare an 8-byte aligned task stack of the given size in bytes */
+#define RUNTIME_TASK_STACK(name, bytes)  static uint64_t name[(bytes) / 8u]
+
+typedef void (*runtime_task_fn)(void *arg);
+
+typedef struct runtime_task {
+    uint32_t        *sp;          /* saved PSP; must stay first (see .s) */
+    uint32_t         prio;
+    runtime_timer_t  sleep_timer; /* backs runtime_sched_sleep_ms() */
+    uint64_t        *stack;       /* base, painted for high-water tracking */
+    uint32_t         stack_bytes;
+} runtime_task_t;
+
+/* Register a task at a unique priority, 0 .. RUNTIME_SCHED_PRIO_MAX.
+ * Returns 0, or -1 if prio is out of range or already taken. Call before
+ * runtime_sched_start().
+ */
+int runtime_sched_add(runtime_task_t *task, runtime_task_fn entry, void *arg,
+                      uint64_t *stack, uint32_t stack_bytes, uint32_t prio);
+
+/* Hand the CPU to the tasks. main() becomes the interrupt stack owner and
+ * never resumes. Requires runtime_init() and IRQs enabled.
+ */
+void runtime_sched_start(void) __attribute__((noreturn));
+
+/* Task currently running (NULL before runtime_sched_start()) */
+runtime_task_t *runtime_sched_current(void);
+
+/* Peak stack bytes task has used so far (runtime_stack.h) */
+uint32_t runtime_sched_stack_used(const runtime_task_t *task);
+
+/* Block the calling task for at least ms milliseconds. Task context.
+ * Before runtime_sched_start() there is no task: runtime_delay_ms(ms).
+ */
+void runtime_sched_sleep_ms(uint32_t ms);
+
+/* Block the calling task until runtime_sched_wake(). Task context.
+ * Before runtime_sched_start() there is no task: returns at once.
+ */
+void runtime_sched_block(void);
+
+/* Make task ready. Safe from ISRs; preempts on exit if task outranks
+ * whatever is running.
+ */
+void runtime_sched_wake(runtime_task_t *task);
+
+#endif /* RUNTIME_SCHED_H */
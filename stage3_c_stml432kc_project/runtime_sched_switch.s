@@ -0,0 +1,47 @@
+/* runtime_sched_switch.s — PendSV context switch for runtime_sched.c
+ *
+ * Saves r4-r11 and EXC_RETURN (plus s16-s31 when the outgoing task has an
+ * FP frame) on the outgoing task's PSP stack, then restores the incoming
+ * task the same way. The hardware frame (r0-r3, r12, lr, pc, xPSR and, if
+ * lazily stacked, s0-s15) is handled by exception entry/return.
+ *
+ * runtime_task_t layout: offset 0 = saved sp.
+ */
+
+.syntax unified
+.cpu cortex-m4
+.fpu fpv4-sp-d16
+.thumb
+
+.global PendSV_Handler
+
+.section .text.PendSV_Handler,"ax",%progbits
+.type PendSV_Handler, %function
+.thumb_func
+PendSV_Handler:
+  cpsid i
+  ldr   r2, =g_sched_current
+  ldr   r1, [r2]
+  cbz   r1, 1f                /* first switch: nothing to save */
+
+  mrs   r0, psp
+  tst   lr, #0x10             /* EXC_RETURN[4] == 0: FP frame active */
+  it    eq
+  vstmdbeq r0!, {s16-s31}
+  stmdb r0!, {r4-r11, lr}
+  str   r0, [r1]              /* current->sp */
+
+1:
+  ldr   r3, =g_sched_next
+  ldr   r1, [r3]
+  str   r1, [r2]              /* current = next */
+
+  ldr   r0, [r1]              /* next->sp */
+  ldmia r0!, {r4-r11, lr}
+  tst   lr, #0x10
+  it    eq
+  vldmiaeq r0!, {s16-s31}
+  msr   psp, r0
+  cpsie i
+  bx    lr
+.size PendSV_Handler, . - PendSV_Handler
@@ -0,0 +1,33 @@
+/* runtime_section.h — code and data placement attributes
+ *
+ * Names the output sections that linker.ld maps to specific memories.
+ * Startup copies every one of them through the init tables, so a marked
+ * function or object is ready before main().
+ */
+
+#ifndef RUNTIME_SECTION_H
+#define RUNTIME_SECTION_H
+
+/* Run a function from SRAM2 (0x10000000, I-Code/D-Code bus) instead of
+ * flash: no wait states, no ART cache misses, and no bus contention with
+ * data traffic in SRAM1. Calls between flash and SRAM2 go through linker
+ * long-branch veneers, so keep the hot path inside the function.
+ *
+ *   RUNTIME_RAMFUNC void SysTick_Handler(void) { ... }
+ */
+#define RUNTIME_RAMFUNC  __attribute__((section(".ramfunc"), noinline))
+
+/* Place an object in SRAM2 instead of SRAM1: 16 KiB more working memory,
+ * on the D-Code bus rather than the SRAM1 system bus.
+ *
+ *   RUNTIME_SRAM2_DATA static uint32_t s_table[4] = { 1, 2, 3, 4 };
+ *   RUNTIME_SRAM2_BSS  static uint8_t  s_rx_buf[1024];
+ *
+ * _DATA objects are copied from flash at boot, _BSS objects are zeroed;
+ * both before main(). DMA must be given the SRAM1-side alias of an SRAM2
+ * buffer (MCU_SRAM2_TO_SBUS() in the MCU header).
+ */
+#define RUNTIME_SRAM2_DATA  __attribute__((section(".sram2.data")))
+#define RUNTIME_SRAM2_BSS   __attribute__((section(".sram2.bss")))
+
+#endif /* RUNTIME_SECTION_H */
@@ -0,0 +1,37 @@
+/* runtime_stack.c — stack high-water marks */
+
+#include "runtime_stack.h"
+
+/* linker.ld */
+extern uint32_t _sstack[];
+extern uint32_t _estack[];
+
+void runtime_stack_paint(void *base, uint32_t bytes)
+{
+    uint32_t *p = (uint32_t *)base;
+
+    for (uint32_t n = bytes / 4u; n != 0u; n--) {
+        *p++ = RUNTIME_STACK_PAINT;
+    }
+}
+
+uint32_t runtime_stack_used(const void *base, uint32_t bytes)
+{
+    const volatile uint32_t *p   = (const volatile uint32_t *)base;
+    const volatile uint32_t *end = p + bytes / 4u;
+
+    while ((p < end) && (*p == RUNTIME_STACK_PAINT)) {
+        p++;
+    }
+    return (uint32_t)((const volatile uint8_t *)end - (const volatile uint8_t *)p);
+}
+
+uint32_t runtime_stack_main_size(void)
+{
+    return (uint32_t)((uint8_t *)_estack - (uint8_t *)_sstack);
+}
+
+uint32_t runtime_stack_main_used(void)
+{
+    return runtime_stack_used(_sstack, runtime_stack_main_size());
+}
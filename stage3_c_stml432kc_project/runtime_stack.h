@@ -0,0 +1,34 @@
+/* runtime_stack.h — stack high-water marks
+ *
+ * Stacks are painted with RUNTIME_STACK_PAINT and later scanned from the
+ * low (far) end: the first overwritten word marks the deepest point ever
+ * reached. Reset_Handler paints the main stack (_sstack .. _estack, minus
+ * its own top 32 bytes); runtime_sched_add() paints each task stack.
+ *
+ * Reading a mark costs a scan of the unused part; meant for the debugger
+ * or a periodic health check, not a hot path:
+ *
+ *   (gdb) p runtime_stack_main_used()
+ */
+
+#ifndef RUNTIME_STACK_H
+#define RUNTIME_STACK_H
+
+#include <stdint.h>
+
+/* Must match STACK_PAINT in startup.s */
+#define RUNTIME_STACK_PAINT  (0xA5A5A5A5u)
+
+/* Fill a stack region (word-aligned, must not be in use) */
+void runtime_stack_paint(void *base, uint32_t bytes);
+
+/* Peak bytes used of a painted region growing down from base + bytes */
+uint32_t runtime_stack_used(const void *base, uint32_t bytes);
+
+/* Main (MSP) stack: reservation from linker.ld and its high-water mark.
+ * Once runtime_sched_start() runs, this is the interrupt stack.
+ */
+uint32_t runtime_stack_main_size(void);
+uint32_t runtime_stack_main_used(void);
+
+#endif /* RUNTIME_STACK_H */
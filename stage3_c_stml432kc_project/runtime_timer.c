@@ -0,0 +1,271 @@
+/* runtime_timer.c — hierarchical timer wheel
+ *
+ * Four levels of 32 slots. A level-L slot spans 32^L ms, so the wheel
+ * covers ~17 minutes directly; longer deadlines park in the top level and
+ * are re-filed each time it cascades.
+ *
+ * Level 0 is serviced every tick. Whenever its index wraps to 0, the
+ * matching slot of the next level is cascaded (re-filed relative to now),
+ * and so on upwards. A per-level occupancy bitmap lets the wheel skip runs
+ * of empty level-0 slots, so a stretched SysTick period of n ms costs one
+ * step per occupied slot and per 32 ms cascade boundary, not one per ms.
+ */
+
+#include <stddef.h>
+#include "runtime.h"
+#include "runtime_timer.h"
+#include "arch_cortexm_baremetal.h"
+
+#define WHEEL_BITS    (5u)
+#define WHEEL_SLOTS   (1u << WHEEL_BITS)
+#define WHEEL_MASK    (WHEEL_SLOTS - 1u)
+#define WHEEL_LEVELS  (4u)
+
+/* Largest delta the wheel can file without re-clamping */
+#define WHEEL_SPAN    ((1u << (WHEEL_BITS * WHEEL_LEVELS)) - 1u)
+
+static runtime_timer_t *s_slot[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint32_t         s_occupied[WHEEL_LEVELS];  /* bit n: slot n non-empty */
+static uint32_t         s_armed;                   /* timers on the wheel */
+
+/* Next tick to service; all ticks before it are done */
+static uint32_t s_next_tick;
+
+/* Slot being expired, detached so re-armed timers cannot land back in it.
+ * Its timers carry level == EXPIRING_LEVEL and can still be cancelled.
+ */
+#define EXPIRING_LEVEL  WHEEL_LEVELS
+static runtime_timer_t *s_expiring;
+
+/* ---- list / bitmap primitives (call with IRQs masked) ---- */
+
+static void wheel_link(runtime_timer_t *t, uint32_t level, uint32_t slot)
+{
+    runtime_timer_t **head = &s_slot[level][slot];
+
+    t->next = *head;
+    if (t->next != NULL) {
+        t->next->pprev = &t->next;
+    }
+    t->pprev = head;
+    t->level = level;
+    t->slot  = slot;
+    *head = t;
+
+    s_occupied[level] |= (1u << slot);
+    s_armed++;
+}
+
+static void wheel_unlink(runtime_timer_t *t)
+{
+    *t->pprev = t->next;
+    if (t->next != NULL) {
+        t->next->pprev = t->pprev;
+    }
+
+    if ((t->level != EXPIRING_LEVEL) && (s_slot[t->level][t->slot] == NULL)) {
+        s_occupied[t->level] &= ~(1u << t->slot);
+    }
+
+    t->next  = NULL;
+    t->pprev = NULL;
+    s_armed--;
+}
+
+/* File timer by its distance from s_next_tick */
+static void wheel_insert(runtime_timer_t *t)
+{
+    int32_t  signed_delta = (int32_t)(t->expires - s_next_tick);
+    uint32_t delta;
+    uint32_t at;
+
+    if (signed_delta < 0) {
+        /* Already due: run on the next serviced tick */
+        wheel_link(t, 0u, s_next_tick & WHEEL_MASK);
+        return;
+    }
+
+    delta = (uint32_t)signed_delta;
+    at    = t->expires;
+    if (delta > WHEEL_SPAN) {
+        /* Beyond the wheel: park at the far edge, re-filed on cascade */
+        delta = WHEEL_SPAN;
+        at    = s_next_tick + WHEEL_SPAN;
+    }
+
+    uint32_t level = 0;
+    while ((level < WHEEL_LEVELS - 1u) &&
+           (delta >= (1u << (WHEEL_BITS * (level + 1u))))) {
+        level++;
+    }
+
+    wheel_link(t, level, (at >> (WHEEL_BITS * level)) & WHEEL_MASK);
+}
+
+/* Re-file one upper-level slot; its timers land in lower levels */
+static void wheel_cascade(uint32_t level, uint32_t slot)
+{
+    runtime_timer_t *t;
+
+    while ((t = s_slot[level][slot]) != NULL) {
+        wheel_unlink(t);
+        wheel_insert(t);
+    }
+}
+
+/* ---- public API ---- */
+
+void runtime_timer_init(runtime_timer_t *timer, runtime_timer_fn fn, void *arg)
+{
+    timer->next    = NULL;
+    timer->pprev   = NULL;
+    timer->expires = 0;
+    timer->period  = 0;
+    timer->level   = 0;
+    timer->slot    = 0;
+    timer->fn      = fn;
+    timer->arg     = arg;
+}
+
+void runtime_timer_start(runtime_timer_t *timer, uint32_t delay_ms, uint32_t period_ms)
+{
+    if (delay_ms == 0u) {
+        delay_ms = 1u;
+    }
+
+    uint32_t primask = arch_irq_save();
+
+    if (timer->pprev != NULL) {
+        wheel_unlink(timer);
+    }
+    uint32_t now = runtime_millis();
+    if (s_armed == 0u) {
+        /* Idle wheel: nothing to service between s_next_tick and now */
+        s_next_tick = now;
+    }
+    timer->expires = now + delay_ms;
+    timer->period  = period_ms;
+    wheel_insert(timer);
+
+    /* SysTick may be stretched past the new deadline */
+    runtime_tick_deadline(timer->expires);
+
+    arch_irq_restore(primask);
+}
+
+void runtime_timer_cancel(runtime_timer_t *timer)
+{
+    uint32_t primask = arch_irq_save();
+
+    if (timer->pprev != NULL) {
+        wheel_unlink(timer);
+    }
+
+    arch_irq_restore(primask);
+}
+
+int runtime_timer_active(const runtime_timer_t *timer)
+{
+    return timer->pprev != NULL;
+}
+
+void runtime_timer_advance(uint32_t now_ms)
+{
+    uint32_t primask = arch_irq_save();
+
+    while ((int32_t)(now_ms - s_next_tick) >= 0) {
+        uint32_t tick = s_next_tick;
+        uint32_t idx  = tick & WHEEL_MASK;
+
+        /* Level index wrapped: pull the next level's slot down, and keep
+         * going up while each higher index wraps as well.
+         */
+        for (uint32_t level = 1; (idx == 0u) && (level < WHEEL_LEVELS); level++) {
+            idx = (tick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+            wheel_cascade(level, idx);
+        }
+        idx = tick & WHEEL_MASK;
+
+        /* Anything re-armed from a callback files relative to tick + 1 */
+        s_next_tick = tick + 1u;
+
+        runtime_timer_t *t = s_slot[0][idx];
+        s_expiring = t;
+        if (t != NULL) {
+            t->pprev = &s_expiring;
+        }
+        for (; t != NULL; t = t->next) {
+            t->level = EXPIRING_LEVEL;
+        }
+        s_slot[0][idx] = NULL;
+        s_occupied[0] &= ~(1u << idx);
+
+        while ((t = s_expiring) != NULL) {
+            wheel_unlink(t);
+            if (t->period != 0u) {
+                t->expires += t->period;
+                wheel_insert(t);
+            }
+
+            /* Callbacks run with the caller's interrupt state */
+            arch_irq_restore(primask);
+            t->fn(t, t->arg);
+            primask = arch_irq_save();
+        }
+
+        /* Skip empty level-0 slots up to the next occupied one or the
+         * next cascade boundary, but never past now_ms.
+         */
+        uint32_t pos = s_next_tick & WHEEL_MASK;
+        if (pos != 0u) {
+            uint32_t ahead = s_occupied[0] & (~0u << pos);
+            uint32_t skip  = (ahead != 0u) ? ((uint32_t)__builtin_ctz(ahead) - pos)
+                                           : (WHEEL_SLOTS - pos);
+            uint32_t left  = now_ms + 1u - s_next_tick;
+            s_next_tick += (skip < left) ? skip : left;
+        }
+    }
+
+    arch_irq_restore(primask);
+}
+
+void runtime_timer_poll(void)
+{
+    runtime_timer_advance(runtime_millis());
+}
+
+int runtime_timer_next_due(uint32_t *due_ms)
+{
+    uint32_t primask = arch_irq_save();
+
+    if (s_armed == 0u) {
+        arch_irq_restore(primask);
+        return 0;
+    }
+
+    uint32_t pos   = s_next_tick & WHEEL_MASK;
+    uint32_t upper = 0;
+    for (uint32_t level = 1; level < WHEEL_LEVELS; level++) {
+        upper |= s_occupied[level];
+    }
+
+    uint32_t dist;
+    uint32_t ahead = s_occupied[0] & (~0u << pos);
+    if ((upper != 0u) && (pos == 0u)) {
+        /* s_next_tick itself is a cascade boundary */
+        dist = 0u;
+    } else if (ahead != 0u) {
+        dist = (uint32_t)__builtin_ctz(ahead) - pos;
+    } else if (upper != 0u) {
+        /* Must wake at the boundary to cascade */
+        dist = WHEEL_SLOTS - pos;
+    } else {
+        /* Only level 0 is populated, and only behind pos: wrap around */
+        dist = (uint32_t)__builtin_ctz(s_occupied[0]) + WHEEL_SLOTS - pos;
+    }
+
+    *due_ms = s_next_tick + dist;
+
+    arch_irq_restore(primask);
+    return 1;
+}
@@ -0,0 +1,64 @@
+/* runtime_timer.h — software timers on a hierarchical timer wheel
+ *
+ * One-shot and periodic deadline callbacks driven by the SysTick timebase.
+ * Timers are caller-owned (intrusive, no allocation). Arm and cancel
+ * take constant time; on its way to expiry a timer is re-filed at most
+ * once per wheel level it cascades through, plus once per top-level
+ * cascade while its deadline is beyond the wheel's ~17 minutes.
+ *
+ * Callbacks run from SysTick_Handler, or from runtime_timer_poll() when
+ * built with RUNTIME_TIMER_DEFERRED. Keep them short either way.
+ */
+
+#ifndef RUNTIME_TIMER_H
+#define RUNTIME_TIMER_H
+
+#include <stdint.h>
+
+typedef struct runtime_timer runtime_timer_t;
+
+typedef void (*runtime_timer_fn)(runtime_timer_t *timer, void *arg);
+
+/* Treat as opaque; fields are exposed only so timers can be static. */
+struct runtime_timer {
+    runtime_timer_t  *next;
+    runtime_timer_t **pprev;    /* NULL when not armed */
+    uint32_t          expires;  /* absolute runtime_millis() deadline */
+    uint32_t          period;   /* 0 = one-shot */
+    uint32_t          level;    /* wheel level holding the timer */
+    uint32_t          slot;     /* slot within that level */
+    runtime_timer_fn  fn;
+    void             *arg;
+};
+
+/* Bind a callback. Must be called before the first start. */
+void runtime_timer_init(runtime_timer_t *timer, runtime_timer_fn fn, void *arg);
+
+/* Arm timer to fire delay_ms from now (at least 1 ms), then every
+ * period_ms if period_ms != 0. Re-arming an armed timer moves it.
+ * Safe from thread and ISR context, including from its own callback.
+ * If SysTick is stretched past the new deadline, the stretch is cut short.
+ */
+void runtime_timer_start(runtime_timer_t *timer, uint32_t delay_ms, uint32_t period_ms);
+
+/* Disarm timer. No-op if it is not armed. */
+void runtime_timer_cancel(runtime_timer_t *timer);
+
+/* Nonzero while timer is armed */
+int runtime_timer_active(const runtime_timer_t *timer);
+
+/* Run every timer due up to and including now_ms.
+ * Called by SysTick_Handler with the credited tick count.
+ */
+void runtime_timer_advance(uint32_t now_ms);
+
+/* Deferred servicing: run due timers from thread context */
+void runtime_timer_poll(void);
+
+/* Earliest tick at which the wheel needs servicing.
+ * Returns 0 if no timer is armed; otherwise stores the tick in *due_ms.
+ * The tickless delay uses it to bound how far SysTick may be stretched.
+ */
+int runtime_timer_next_due(uint32_t *due_ms);
+
+#endif /* RUNTIME_TIMER_H */
@@ -0,0 +1,10 @@
+/* runtime_trace.c — timestamped event trace (flight recorder) */
+
+#include "runtime_trace.h"
+
+#ifdef RUNTIME_TRACE
+/* In .bss: zero head is an empty ring, so recording works before main().
+ * Read by tools/trace_export.py from a RAM dump: keep the name.
+ */
+runtime_trace_t g_trace;
+#endif
@@ -0,0 +1,102 @@
+/* runtime_trace.h — timestamped event trace (flight recorder)
+ *
+ * Begin / end / instant events, each stamped with DWT CYCCNT and the
+ * active exception number, land in g_trace: a RAM ring that always holds
+ * the most recent RUNTIME_TRACE_EVENTS events. Producers claim a slot with
+ * one atomic increment (LDREX/STREX), so threads and ISRs record without
+ * masking interrupts and without a lock.
+ *
+ * Built in with `make TRACE=1` (defines RUNTIME_TRACE); otherwise every
+ * macro compiles to nothing. g_trace needs no init call, so events from
+ * board_init() onwards are kept. Export a RAM dump for Perfetto
+ * (ui.perfetto.dev) or chrome://tracing:
+ *
+ *   (gdb) dump binary memory ram.bin 0x20000000 0x2000C000
+ *   $ python3 tools/trace_export.py build/blink.elf --dump ram.bin -o trace.json
+ *
+ * Names must be string literals (only the pointer is stored; the exporter
+ * reads the text from the ELF).
+ */
+
+#ifndef RUNTIME_TRACE_H
+#define RUNTIME_TRACE_H
+
+#include <stdint.h>
+#include "arch_cortexm_baremetal.h"
+
+/* Ring size in events (power of two) */
+#ifndef RUNTIME_TRACE_EVENTS
+#define RUNTIME_TRACE_EVENTS  (256u)
+#endif
+
+_Static_assert((RUNTIME_TRACE_EVENTS & (RUNTIME_TRACE_EVENTS - 1u)) == 0u,
+               "RUNTIME_TRACE_EVENTS must be a power of two");
+
+/* Event types, stored as their Chrome trace "ph" letter */
+#define RUNTIME_TRACE_TYPE_BEGIN    ((uint16_t)'B')
+#define RUNTIME_TRACE_TYPE_END      ((uint16_t)'E')
+#define RUNTIME_TRACE_TYPE_INSTANT  ((uint16_t)'i')
+#define RUNTIME_TRACE_TYPE_CLOCK    ((uint16_t)'C')  /* core clock changed */
+
+typedef struct {
+    uint32_t        cycles;  /* DWT CYCCNT */
+    union {
+        const char *name;    /* BEGIN / END / INSTANT */
+        uint32_t    value;   /* CLOCK: the new core clock in Hz */
+    };
+    uint16_t        ctx;     /* IPSR: 0 thread, 15 SysTick, 16+n IRQn */
+    uint16_t        type;    /* RUNTIME_TRACE_TYPE_* */
+} runtime_trace_event_t;
+
+typedef struct {
+    volatile uint32_t     head;    /* events ever recorded; next slot = head & mask */
+    uint32_t              hz;      /* latest RUNTIME_TRACE_CLOCK value */
+    runtime_trace_event_t ev[RUNTIME_TRACE_EVENTS];
+} runtime_trace_t;
+
+#ifdef RUNTIME_TRACE
+
+extern runtime_trace_t g_trace;
+
+/* Claim the next slot and stamp it; the caller fills name or value */
+static inline runtime_trace_event_t *runtime_trace_claim(uint16_t type)
+{
+    uint32_t slot = __atomic_fetch_add(&g_trace.head, 1u, __ATOMIC_RELAXED)
+                    & (RUNTIME_TRACE_EVENTS - 1u);
+    runtime_trace_event_t *e = &g_trace.ev[slot];
+
+    e->cycles = arch_cyccnt();
+    e->ctx    = (uint16_t)arch_ipsr();
+    e->type   = type;
+    return e;
+}
+
+static inline void runtime_trace_record(uint16_t type, const char *name)
+{
+    runtime_trace_claim(type)->name = name;
+}
+
+/* Cycles only become time with the clock they ran at: record every change.
+ * Until the first one the exporter assumes the reset clock (MSI 4 MHz).
+ */
+static inline void runtime_trace_clock(uint32_t hz)
+{
+    g_trace.hz = hz;
+    runtime_trace_claim(RUNTIME_TRACE_TYPE_CLOCK)->value = hz;
+}
+
+#define RUNTIME_TRACE_BEGIN(name)   runtime_trace_record(RUNTIME_TRACE_TYPE_BEGIN, name)
+#define RUNTIME_TRACE_END(name)     runtime_trace_record(RUNTIME_TRACE_TYPE_END, name)
+#define RUNTIME_TRACE_INSTANT(name) runtime_trace_record(RUNTIME_TRACE_TYPE_INSTANT, name)
+#define RUNTIME_TRACE_CLOCK(hz)     runtime_trace_clock(hz)
+
+#else
+
+#define RUNTIME_TRACE_BEGIN(name)   ((void)0)
+#define RUNTIME_TRACE_END(name)     ((void)0)
+#define RUNTIME_TRACE_INSTANT(name) ((void)0)
+#define RUNTIME_TRACE_CLOCK(hz)     ((void)(hz))
+
+#endif /* RUNTIME_TRACE */
+
+#endif /* RUNTIME_TRACE_H */
@@ -7,8 +7,23 @@
 .global  Default_Handler
 .global  SysTick_Handler
 
-/* Minimal vector table.
- * We only wire Reset_Handler; everything else loops in Default_Handler.
+/* Early reset signature pulse width, in core cycles */
+.equ RESET_PULSE_CYCLES, 400
+
+/* Stack paint word and the unpainted top of the stack, which holds
+ * Reset_Handler's own call frames (runtime_stack.h)
+ */
+.equ STACK_PAINT,     0xA5A5A5A5
+.equ STACK_PAINT_TOP, 32
+
+/* External IRQ lines on the STM32L43x (mcu_stm32l4xx_baremetal.h) */
+.equ MCU_IRQ_COUNT, 85
+
+/* Boot vector table (flash).
+ * Wires Reset_Handler, PendSV and SysTick; every other exception and all
+ * external IRQs loop in Default_Handler. Reset_Handler copies it to RAM
+ * (linker copy table) and moves VTOR there; runtime_irq_attach() edits
+ * the copy.
  */
 .section .isr_vector,"a",%progbits
 .align 2
@@ -32,13 +47,19 @@ g_pfnVectors:
   .word  Default_Handler + 1 /* SVCall */
   .word  Default_Handler + 1 /* DebugMon */
   .word  0
-  .word  Default_Handler + 1 /* PendSV */
-  .word  SysTick_Handler + 1 /* SysTick */
+  .word  PendSV_Handler      /* PendSV (runtime_sched_switch.s) */
+  .word  SysTick_Handler     /* SysTick (C, runtime.c) */
+  .rept  MCU_IRQ_COUNT
+  .word  Default_Handler + 1 /* IRQ0 .. IRQ84 */
+  .endr
 .size g_pfnVectors, . - g_pfnVectors
 
 /* Reset handler:
- * - Copy .data from FLASH to RAM
- * - Zero .bss
+ * - Enable the FPU, with lazy FP state preservation
+ * - Copy every region in the linker copy table (.data, vectors, ...)
+ * - Zero every region in the linker zero table (.bss, ...)
+ * - Paint the stack reservation for high-water tracking
+ * - Point VTOR at the RAM vector table
  * - Call main()
  * - If main returns, loop
  */
@@ -52,6 +73,24 @@ Reset_Handler:
   ldr r1, =0x08000000
   str r1, [r0]
 
+  /* FPU before any C: the default build is hard-float, and an FP
+   * instruction with CP10/CP11 off is a NOCP UsageFault.
+   * CPACR: full access to CP10/CP11.
+   * FPCCR: ASPEN | LSPEN (the reset value, made explicit): exception
+   * entry only reserves the FP frame; it is written if the handler
+   * itself uses the FPU, so integer-only ISRs pay nothing.
+   */
+  ldr r0, =0xE000ED88     /* SCB_CPACR */
+  ldr r1, [r0]
+  orr r1, r1, #(0xF << 20)
+  str r1, [r0]
+  ldr r0, =0xE000EF34     /* FPU_FPCCR */
+  ldr r1, [r0]
+  orr r1, r1, #(3 << 30)  /* ASPEN | LSPEN */
+  str r1, [r0]
+  dsb
+  isb
+
   /* EARLY RESET SIGNATURE: PB3 ON briefly, then OFF */
 
   /* Enable GPIOB clock: RCC_AHB2ENR |= (1<<1) */
@@ -83,44 +122,80 @@ Reset_Handler:
   movw r2, #(1 << 3)
   str r2, [r0, #0x18]     /* BSRR */
 
-  /* short delay */
-  movs r3, #0
-1: adds r3, r3, #1
-   cmp r3, #200
-   blt 1b
+  /* Pulse width: RESET_PULSE_CYCLES core cycles on DWT CYCCNT
+   * (100 us at the 4 MHz reset MSI), independent of loop timing.
+   */
+  ldr r1, =0xE000EDFC     /* DEMCR */
+  ldr r2, [r1]
+  orr r2, r2, #(1 << 24)  /* TRCENA */
+  str r2, [r1]
+  ldr r1, =0xE0001000     /* DWT_CTRL */
+  ldr r2, [r1]
+  orr r2, r2, #(1 << 0)   /* CYCCNTENA */
+  str r2, [r1]
+  ldr r3, [r1, #4]        /* start = DWT_CYCCNT */
+1: ldr r2, [r1, #4]
+   subs r2, r2, r3
+   cmp r2, #RESET_PULSE_CYCLES
+   blo 1b
 
   /* PB3 OFF */
   ldr r2, =0x00080000
   str r2, [r0, #0x18]     /* BSRR */
 
 
-  /* Copy .data */
-  ldr r0, =_sidata
-  ldr r1, =_sdata
-  ldr r2, =_edata
+  /* Boot-phase timing: r7 = &DWT_CYCCNT (running since the pulse above),
+   * r8/r9/r10 = timestamps around the copy and zero table passes.
+   */
+  ldr r7, =0xE0001004     /* DWT_CYCCNT */
+  ldr r8, [r7]
+
+  /* Copy table (linker.ld): {load addr, run addr, bytes} per region */
+  ldr r4, =__copy_table_start
+  ldr r5, =__copy_table_end
 1:
-  cmp r1, r2
-  bcc 2f
-  b   3f
-2:
-  ldr r3, [r0], #4
-  str r3, [r1], #4
+  cmp r4, r5
+  bhs 2f
+  ldmia r4!, {r0-r2}
+  bl  startup_region_copy
   b   1b
 
+2:
+  ldr r9, [r7]
+
+  /* Zero table (linker.ld): {run addr, bytes} per region */
+  ldr r4, =__zero_table_start
+  ldr r5, =__zero_table_end
 3:
-  /* Zero .bss */
-  ldr r0, =_sbss
-  ldr r1, =_ebss
+  cmp r4, r5
+  bhs 4f
+  ldmia r4!, {r0-r1}
+  bl  startup_region_zero
+  b   3b
+
 4:
-  cmp r0, r1
-  bcc 5f
-  b   6f
-5:
-  movs r2, #0
-  str r2, [r0], #4
-  b   4b
+  ldr r10, [r7]
+
+  /* Publish phase costs now that .bss (g_boot_cycles) is cleared */
+  ldr r0, =g_boot_cycles
+  subs r1, r9, r8
+  str r1, [r0, #0]        /* copy_table */
+  subs r1, r10, r9
+  str r1, [r0, #4]        /* zero_table */
 
-6:
+  /* Paint [_sstack, _estack - STACK_PAINT_TOP) for runtime_stack_used() */
+  ldr r0, =_sstack
+  ldr r1, =_estack - STACK_PAINT_TOP
+  subs r1, r1, r0
+  ldr r2, =STACK_PAINT
+  bl  startup_region_fill
+
+  /* Vectors now live in RAM (copied above); switch VTOR over */
+  ldr r0, =0xE000ED08     /* SCB_VTOR */
+  ldr r1, =__vectors_ram_start
+  str r1, [r0]
+  dsb
+  isb
 
   cpsid i
   ldr r0, =0xE000E010    /* SYST_CSR */
@@ -133,18 +208,80 @@ Reset_Handler:
 7:
   b 7b
 
+/* startup_region_copy(src, dst, bytes)
+ * bytes must be a multiple of 4. 32-byte LDM/STM bursts, then a word tail.
+ * AAPCS-clean so C (benchmarks) can call it too.
+ */
+.section .text.startup_region_copy,"ax",%progbits
+.global startup_region_copy
+.type startup_region_copy, %function
+.thumb_func
+startup_region_copy:
+  push  {r4-r10}
+  subs  r2, r2, #32
+  blo   2f
+1:
+  ldmia r0!, {r3-r10}
+  stmia r1!, {r3-r10}
+  subs  r2, r2, #32
+  bhs   1b
+2:
+  adds  r2, r2, #32       /* 0..28 bytes left */
+  beq   4f
+3:
+  ldr   r3, [r0], #4
+  str   r3, [r1], #4
+  subs  r2, r2, #4
+  bne   3b
+4:
+  pop   {r4-r10}
+  bx    lr
+.size startup_region_copy, . - startup_region_copy
+
+/* startup_region_zero(dst, bytes)
+ * startup_region_fill(dst, bytes, word)
+ * bytes must be a multiple of 4. 32-byte STM bursts, then a word tail.
+ */
+.section .text.startup_region_zero,"ax",%progbits
+.global startup_region_zero
+.type startup_region_zero, %function
+.thumb_func
+startup_region_zero:
+  movs  r2, #0
+  /* fall through */
+
+.global startup_region_fill
+.type startup_region_fill, %function
+.thumb_func
+startup_region_fill:
+  push  {r4-r5}
+  mov   r3, r2
+  mov   r4, r2
+  mov   r5, r2
+  subs  r1, r1, #32
+  blo   2f
+1:
+  stmia r0!, {r2-r5}
+  stmia r0!, {r2-r5}
+  subs  r1, r1, #32
+  bhs   1b
+2:
+  adds  r1, r1, #32       /* 0..28 bytes left */
+  beq   4f
+3:
+  str   r2, [r0], #4
+  subs  r1, r1, #4
+  bne   3b
+4:
+  pop   {r4-r5}
+  bx    lr
+.size startup_region_zero, . - startup_region_zero
+.size startup_region_fill, . - startup_region_fill
+
 .section .text.Default_Handler,"ax",%progbits
 Default_Handler:
 8:
   wfe
   b 8b
 
-.section .text.SysTick_Handler,"ax",%progbits
-SysTick_Handler:
-  ldr r0, =g_systick_ms
-  ldr r1, [r0]
-  adds r1, r1, #1
-  str r1, [r0]
-  bx lr
-
 
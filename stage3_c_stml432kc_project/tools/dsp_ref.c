@@ -0,0 +1,354 @@
+/* dsp_ref.c — host reference for the runtime_dsp kernels (make dsp-ref)
+ *
+ * Builds runtime_dsp.c with the host compiler, where arch_cortexm_dsp.h
+ * falls back to portable C, and checks it against the textbook formulas
+ * below: plain loops over the whole input stream, no block state, no
+ * packed arithmetic. Every case of bench_dsp_cases.h runs for REF_PASSES
+ * blocks (so carried filter state is covered), then FIR and biquad run
+ * again with gains that drive the outputs into saturation.
+ *
+ * It then prints the first-pass checksums, which a target `make
+ * BENCH=dsp` run must reproduce in g_bench_dsp.kernel[i].check, and
+ * compares them with the values pinned in s_expect[]. Any mismatch
+ * exits nonzero.
+ *
+ *   $ make dsp-ref
+ *   (gdb) p/x g_bench_dsp.kernel
+ */
+
+#include <stdio.h>
+
+#include "bench_dsp_cases.h"
+
+#define REF_PASSES  (3u)
+#define REF_LEN     (REF_PASSES * BENCH_DSP_BLOCK)
+
+/* First-pass checksums (bench_dsp_case_check) for the inputs in
+ * bench_dsp_cases.h; update together with those inputs
+ */
+static const uint32_t s_expect[DSP_CASE_COUNT] = {
+    0xa455fd7cu, 0xe467948du, 0xac29ebbdu, 0x4ba8810eu, 0xd38fd78bu,
+    0x3002f105u, 0x9a84307fu, 0x2a75292au, 0x7f28f18cu, 0x4fd4659du,
+};
+
+static unsigned s_fail;
+
+/* ============================
+   Scalar reference
+   ============================ */
+
+static int32_t ref_sat(int64_t x, int64_t lo, int64_t hi)
+{
+    return (int32_t)((x < lo) ? lo : ((x > hi) ? hi : x));
+}
+
+static int32_t ref_sat15(int64_t x)
+{
+    return ref_sat(x, INT16_MIN, INT16_MAX);
+}
+
+static int32_t ref_sat31(int64_t x)
+{
+    return ref_sat(x, INT32_MIN, INT32_MAX);
+}
+
+/* Floor division by 2^s, independent of how >> treats negative values */
+static int64_t ref_floor_shift(int64_t x, uint32_t s)
+{
+    int64_t d = (int64_t)1 << s;
+    int64_t q = x / d;
+    return ((x % d) < 0) ? q - 1 : q;
+}
+
+/* The block input repeated: the stream the kernels see over the passes */
+static int64_t s_x15[REF_LEN];
+static int64_t s_x31[REF_LEN];
+static int64_t s_ref[REF_LEN];
+
+/* y[t] = sat(floor(sum c[k] x[t-k] / 2^frac)), x before the start = 0 */
+static void ref_fir(const int64_t *x, const int64_t *coef, uint32_t taps, uint32_t frac,
+                    int q15, int64_t *y)
+{
+    for (uint32_t t = 0; t < REF_LEN; t++) {
+        int64_t acc = 0;
+        for (uint32_t k = 0; k < taps && k <= t; k++) {
+            acc += coef[k] * x[t - k];
+        }
+        acc  = ref_floor_shift(acc, frac);
+        y[t] = q15 ? ref_sat15(acc) : ref_sat31(acc);
+    }
+}
+
+/* Direct form I, one stage after another over the whole stream */
+static void ref_biquad(const int64_t *x, const int64_t *coef, uint32_t stages,
+                       uint32_t shift, int q15, int64_t *y)
+{
+    static int64_t in[REF_LEN];
+
+    for (uint32_t t = 0; t < REF_LEN; t++) {
+        in[t] = x[t];
+    }
+    for (uint32_t s = 0; s < stages; s++) {
+        const int64_t *c = &coef[5u * s];
+        for (uint32_t t = 0; t < REF_LEN; t++) {
+            int64_t acc = c[0] * in[t];
+            if (t >= 1u) {
+                acc += c[1] * in[t - 1u] + c[3] * y[t - 1u];
+            }
+            if (t >= 2u) {
+                acc += c[2] * in[t - 2u] + c[4] * y[t - 2u];
+            }
+            acc  = ref_floor_shift(acc, shift);
+            y[t] = q15 ? ref_sat15(acc) : ref_sat31(acc);
+        }
+        for (uint32_t t = 0; t < REF_LEN; t++) {
+            in[t] = y[t];
+        }
+    }
+}
+
+/* Mean of the last 2^shift samples, zeros before the start */
+static void ref_movavg(const int64_t *x, uint32_t shift, int64_t *y)
+{
+    for (uint32_t t = 0; t < REF_LEN; t++) {
+        int64_t sum = 0;
+        for (uint32_t k = 0; k < (1u << shift) && k <= t; k++) {
+            sum += x[t - k];
+        }
+        y[t] = ref_floor_shift(sum, shift);
+    }
+}
+
+/* ============================
+   Comparison
+   ============================ */
+
+static void expect_block(const char *name, uint32_t pass, const int64_t *want,
+                         const void *got, int q15, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t v = q15 ? ((const runtime_q15_t *)got)[i]
+                        : ((const runtime_q31_t *)got)[i];
+        if (v != want[i]) {
+            printf("FAIL %-11s pass %u out[%u] = %lld, reference %lld\n", name,
+                   (unsigned)pass, (unsigned)i, (long long)v, (long long)want[i]);
+            s_fail++;
+            return;
+        }
+    }
+}
+
+static void expect_value(const char *name, int64_t got, int64_t want)
+{
+    if (got != want) {
+        printf("FAIL %-11s %lld, reference %lld\n", name, (long long)got, (long long)want);
+        s_fail++;
+    }
+}
+
+static void check_dot(void)
+{
+    int64_t q15 = 0;
+    int64_t q31 = 0;
+
+    for (uint32_t i = 0; i < BENCH_DSP_BLOCK - 1u; i++) {
+        q15 += (int64_t)s_dsp_in_q15[i] * s_dsp_in_q15[i + 1u];
+        q31 += ref_floor_shift((int64_t)s_dsp_in_q31[i] * s_dsp_in_q31[i + 1u], 14u);
+    }
+    for (uint32_t pass = 0; pass < REF_PASSES; pass++) {
+        bench_dsp_case_run(DSP_DOT_Q15);
+        expect_value("dot_q15", s_dsp_dot, q15);
+        bench_dsp_case_run(DSP_DOT_Q31);
+        expect_value("dot_q31", s_dsp_dot, q31);
+    }
+}
+
+/* Run case id for every pass and compare each block with ref[] */
+static void check_stream(uint32_t id, const int64_t *ref, int q15)
+{
+    for (uint32_t pass = 0; pass < REF_PASSES; pass++) {
+        bench_dsp_case_run(id);
+        expect_block(bench_dsp_case_name[id], pass, &ref[pass * BENCH_DSP_BLOCK],
+                     q15 ? (const void *)s_dsp_out_q15 : (const void *)s_dsp_out_q31,
+                     q15, BENCH_DSP_BLOCK);
+    }
+}
+
+static void check_decimate(uint32_t id, const int64_t *fir, int q15)
+{
+    static int64_t kept[BENCH_DSP_BLOCK];
+
+    for (uint32_t pass = 0; pass < REF_PASSES; pass++) {
+        uint32_t m = 0;
+        for (uint32_t i = BENCH_DSP_DECIM - 1u; i < BENCH_DSP_BLOCK; i += BENCH_DSP_DECIM) {
+            kept[m++] = fir[pass * BENCH_DSP_BLOCK + i];
+        }
+        bench_dsp_case_run(id);
+        expect_value(bench_dsp_case_name[id], s_dsp_out_n, m);
+        expect_block(bench_dsp_case_name[id], pass, kept,
+                     q15 ? (const void *)s_dsp_out_q15 : (const void *)s_dsp_out_q31,
+                     q15, m);
+    }
+}
+
+static void check_cases(void)
+{
+    static int64_t coef15[BENCH_DSP_TAPS];
+    static int64_t coef31[BENCH_DSP_TAPS];
+    static int64_t iir15[5u * BENCH_DSP_STAGES];
+    static int64_t iir31[5u * BENCH_DSP_STAGES];
+
+    bench_dsp_setup();
+
+    for (uint32_t t = 0; t < REF_LEN; t++) {
+        s_x15[t] = s_dsp_in_q15[t % BENCH_DSP_BLOCK];
+        s_x31[t] = s_dsp_in_q31[t % BENCH_DSP_BLOCK];
+    }
+    for (uint32_t k = 0; k < BENCH_DSP_TAPS; k++) {
+        coef15[k] = s_dsp_coef_q15[k];
+        coef31[k] = s_dsp_coef_q31[k];
+    }
+    for (uint32_t k = 0; k < 5u * BENCH_DSP_STAGES; k++) {
+        iir15[k] = s_dsp_biquad_q15[k];
+        iir31[k] = s_dsp_biquad_q31[k];
+    }
+
+    check_dot();
+
+    ref_fir(s_x15, coef15, BENCH_DSP_TAPS, 15u, 1, s_ref);
+    check_stream(DSP_FIR_Q15, s_ref, 1);
+    check_decimate(DSP_DECIM_Q15, s_ref, 1);
+
+    ref_fir(s_x31, coef31, BENCH_DSP_TAPS, 31u, 0, s_ref);
+    check_stream(DSP_FIR_Q31, s_ref, 0);
+    check_decimate(DSP_DECIM_Q31, s_ref, 0);
+
+    ref_biquad(s_x15, iir15, BENCH_DSP_STAGES, 15u - 1u, 1, s_ref);
+    check_stream(DSP_BIQUAD_Q15, s_ref, 1);
+    ref_biquad(s_x31, iir31, BENCH_DSP_STAGES, 31u - 1u, 0, s_ref);
+    check_stream(DSP_BIQUAD_Q31, s_ref, 0);
+
+    ref_movavg(s_x15, BENCH_DSP_AVG_LOG2, s_ref);
+    check_stream(DSP_MOVAVG_Q15, s_ref, 1);
+    ref_movavg(s_x31, BENCH_DSP_AVG_LOG2, s_ref);
+    check_stream(DSP_MOVAVG_Q31, s_ref, 0);
+}
+
+/* ============================
+   Saturation
+   ============================ */
+
+static uint32_t count_rails(const int64_t *y, int q15)
+{
+    uint32_t n = 0;
+
+    for (uint32_t t = 0; t < REF_LEN; t++) {
+        if (q15 ? ((y[t] == INT16_MAX) || (y[t] == INT16_MIN))
+                : ((y[t] == INT32_MAX) || (y[t] == INT32_MIN))) {
+            n++;
+        }
+    }
+    return n;
+}
+
+/* Gains well above 1 on full-scale noise: a large share of the outputs
+ * sits on the rails, and each must match the reference exactly
+ */
+static void check_saturation(void)
+{
+    enum { HOT_TAPS15 = 5, HOT_TAPS31 = 3 };
+    static runtime_q15_t  hot15[HOT_TAPS15] = { 0x4000, 0x3000, -0x2000, 0x4000, 0x2000 };
+    static runtime_q31_t  hot31[HOT_TAPS31] = { 0x60000000, -0x60000000, 0x60000000 };
+    static int64_t        coef[5u * BENCH_DSP_STAGES];
+    static runtime_q15_t  st15[HOT_TAPS15 - 1 + BENCH_DSP_BLOCK];
+    static runtime_q31_t  st31[HOT_TAPS31 - 1 + BENCH_DSP_BLOCK];
+    runtime_dsp_fir_q15_t f15;
+    runtime_dsp_fir_q31_t f31;
+    uint32_t              rails[4];
+
+    bench_dsp_setup();
+
+    for (uint32_t k = 0; k < HOT_TAPS15; k++) {
+        coef[k] = hot15[k];
+    }
+    ref_fir(s_x15, coef, HOT_TAPS15, 15u, 1, s_ref);
+    rails[0] = count_rails(s_ref, 1);
+    runtime_dsp_fir_q15_init(&f15, hot15, HOT_TAPS15, st15, BENCH_DSP_BLOCK);
+    for (uint32_t pass = 0; pass < REF_PASSES; pass++) {
+        runtime_dsp_fir_q15(&f15, s_dsp_in_q15, s_dsp_out_q15, BENCH_DSP_BLOCK);
+        expect_block("fir_q15 sat", pass, &s_ref[pass * BENCH_DSP_BLOCK],
+                     s_dsp_out_q15, 1, BENCH_DSP_BLOCK);
+    }
+
+    for (uint32_t k = 0; k < HOT_TAPS31; k++) {
+        coef[k] = hot31[k];
+    }
+    ref_fir(s_x31, coef, HOT_TAPS31, 31u, 0, s_ref);
+    rails[1] = count_rails(s_ref, 0);
+    runtime_dsp_fir_q31_init(&f31, hot31, HOT_TAPS31, st31, BENCH_DSP_BLOCK);
+    for (uint32_t pass = 0; pass < REF_PASSES; pass++) {
+        runtime_dsp_fir_q31(&f31, s_dsp_in_q31, s_dsp_out_q31, BENCH_DSP_BLOCK);
+        expect_block("fir_q31 sat", pass, &s_ref[pass * BENCH_DSP_BLOCK],
+                     s_dsp_out_q31, 0, BENCH_DSP_BLOCK);
+    }
+
+    /* The bench biquads with post_shift 3 instead of 1: gain x4 */
+    for (uint32_t k = 0; k < 5u * BENCH_DSP_STAGES; k++) {
+        coef[k] = s_dsp_biquad_q15[k];
+    }
+    ref_biquad(s_x15, coef, BENCH_DSP_STAGES, 15u - 3u, 1, s_ref);
+    rails[2] = count_rails(s_ref, 1);
+    runtime_dsp_biquad_q15_init(&s_dsp_iir_q15, s_dsp_biquad_q15, BENCH_DSP_STAGES,
+                                s_dsp_biquad_q15_state, 3u);
+    check_stream(DSP_BIQUAD_Q15, s_ref, 1);
+
+    for (uint32_t k = 0; k < 5u * BENCH_DSP_STAGES; k++) {
+        coef[k] = s_dsp_biquad_q31[k];
+    }
+    ref_biquad(s_x31, coef, BENCH_DSP_STAGES, 31u - 3u, 0, s_ref);
+    rails[3] = count_rails(s_ref, 0);
+    runtime_dsp_biquad_q31_init(&s_dsp_iir_q31, s_dsp_biquad_q31, BENCH_DSP_STAGES,
+                                s_dsp_biquad_q31_state, 3u);
+    check_stream(DSP_BIQUAD_Q31, s_ref, 0);
+
+    printf("saturated outputs of %u: fir_q15 %u, fir_q31 %u, biquad_q15 %u, biquad_q31 %u\n",
+           (unsigned)REF_LEN, (unsigned)rails[0], (unsigned)rails[1],
+           (unsigned)rails[2], (unsigned)rails[3]);
+
+    /* A saturation test that never saturates proves nothing */
+    for (uint32_t i = 0; i < 4u; i++) {
+        if (rails[i] == 0u) {
+            printf("FAIL saturation case %u never reaches the rails\n", (unsigned)i);
+            s_fail++;
+        }
+    }
+}
+
+int main(void)
+{
+    check_cases();
+    check_saturation();
+
+    /* First-pass checksums, as bench_dsp.c records them */
+    bench_dsp_setup();
+    for (uint32_t id = 0; id < DSP_CASE_COUNT; id++) {
+        uint32_t check;
+
+        bench_dsp_case_run(id);
+        check = bench_dsp_case_check(id);
+        printf("[%2u] %-11s %3u samples  check = 0x%08x%s\n", (unsigned)id,
+               bench_dsp_case_name[id], (unsigned)bench_dsp_case_samples(id),
+               (unsigned)check, (check == s_expect[id]) ? "" : "  MISMATCH");
+        if (check != s_expect[id]) {
+            s_fail++;
+        }
+    }
+
+    if (s_fail != 0u) {
+        printf("FAIL: %u mismatches\n", s_fail);
+        return 1;
+    }
+    printf("ok: %u kernels match the scalar reference over %u blocks, "
+           "saturation included\n", (unsigned)DSP_CASE_COUNT, (unsigned)REF_PASSES);
+    return 0;
+}
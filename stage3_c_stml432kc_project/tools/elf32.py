@@ -0,0 +1,141 @@
+"""elf32.py — just enough ELF32 (little-endian) reading for the host tools
+
+No dependencies beyond the standard library. Gives the host tools:
+sections by name, the symbol table, and bytes at a target address.
+"""
+
+import struct
+
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+STT_OBJECT = 1
+STT_FUNC = 2
+
+
+class Section:
+    def __init__(self, name, sh_type, flags, addr, offset, size):
+        self.name = name
+        self.type = sh_type
+        self.flags = flags
+        self.addr = addr
+        self.offset = offset
+        self.size = size
+
+
+class Symbol:
+    def __init__(self, name, value, size, sym_type, shndx):
+        self.name = name
+        self.value = value
+        self.size = size
+        self.type = sym_type
+        self.shndx = shndx
+
+
+class Elf32:
+    def __init__(self, path):
+        self.path = path
+        with open(path, "rb") as f:
+            self.data = f.read()
+        d = self.data
+        if d[:4] != b"\x7fELF" or d[4] != 1 or d[5] != 1:
+            raise ValueError("%s: not a little-endian ELF32 file" % path)
+
+        (self.entry, _phoff, shoff, _flags, _ehsize, _phentsize, _phnum,
+         shentsize, shnum, shstrndx) = struct.unpack_from("<IIIIHHHHHH", d, 24)
+
+        raw = [struct.unpack_from("<IIIIIIIIII", d, shoff + i * shentsize)
+               for i in range(shnum)]
+        strtab = raw[shstrndx]
+        self.sections = []
+        for sh in raw:
+            name = self._cstr(strtab[4] + sh[0])
+            self.sections.append(Section(name, sh[1], sh[2], sh[3], sh[4], sh[5]))
+
+        self.symbols = []
+        for idx, sh in enumerate(raw):
+            if sh[1] != SHT_SYMTAB:
+                continue
+            names = raw[sh[6]]  # sh_link -> string table
+            for off in range(sh[4], sh[4] + sh[5], 16):
+                st_name, value, size, info, _other, shndx = \
+                    struct.unpack_from("<IIIBBH", d, off)
+                if st_name == 0:
+                    continue
+                self.symbols.append(Symbol(self._cstr(names[4] + st_name),
+                                           value, size, info & 0xF, shndx))
+
+    def _cstr(self, offset):
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("utf-8", "replace")
+
+    def section(self, name):
+        for s in self.sections:
+            if s.name == name:
+                return s
+        return None
+
+    def section_bytes(self, name):
+        s = self.section(name)
+        if s is None or s.type == SHT_NOBITS:
+            return None
+        return self.data[s.offset:s.offset + s.size]
+
+    def symbol(self, name):
+        for s in self.symbols:
+            if s.name == name:
+                return s
+        return None
+
+    def functions(self):
+        """FUNC symbols sorted by address (thumb bit cleared)"""
+        funcs = [Symbol(s.name, s.value & ~1, s.size, s.type, s.shndx)
+                 for s in self.symbols if s.type == STT_FUNC]
+        return sorted(funcs, key=lambda s: s.value)
+
+    def read(self, addr, size):
+        """Bytes at a load-time address, from any allocated section"""
+        for s in self.sections:
+            if (s.flags & SHF_ALLOC) and s.type != SHT_NOBITS and \
+                    s.addr <= addr and addr + size <= s.addr + s.size:
+                off = s.offset + addr - s.addr
+                return self.data[off:off + size]
+        return None
+
+    def read_cstr(self, addr, limit=256):
+        for s in self.sections:
+            if (s.flags & SHF_ALLOC) and s.type != SHT_NOBITS and \
+                    s.addr <= addr < s.addr + s.size:
+                off = s.offset + addr - s.addr
+                end = min(s.offset + s.size, off + limit)
+                raw = self.data[off:end]
+                return raw.split(b"\0", 1)[0].decode("utf-8", "replace")
+        return None
+
+
+class MemoryImage:
+    """Target RAM contents: one or more (base address, bytes) dumps"""
+
+    def __init__(self):
+        self.regions = []
+
+    def add(self, base, data):
+        self.regions.append((base, data))
+
+    def read(self, addr, size):
+        for base, data in self.regions:
+            if base <= addr and addr + size <= base + len(data):
+                return data[addr - base:addr - base + size]
+        raise ValueError("address 0x%08x (+%d) not in any dump" % (addr, size))
+
+    def u32(self, addr):
+        return struct.unpack("<I", self.read(addr, 4))[0]
+
+
+def parse_dump_arg(arg):
+    """'file.bin@0x20000000' -> (path, base); base defaults to SRAM1"""
+    if "@" in arg:
+        path, base = arg.rsplit("@", 1)
+        return path, int(base, 0)
+    return arg, 0x20000000
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""log_decode.py — turn RUNTIME_LOG records back into text
+
+Every record is a token (the address of its format string in the .log_fmt
+section of the ELF) followed by one 32-bit word per conversion. From a RAM
+dump the ring is read through the g_log symbol:
+
+    (gdb) dump binary memory ram.bin 0x20000000 0x2000C000
+    python3 tools/log_decode.py build/blink.elf --dump ram.bin
+
+or from words already drained by runtime_log_drain() (little-endian):
+
+    python3 tools/log_decode.py build/blink.elf --stream uart.bin
+
+Supported conversions: d i u x X o c s p and %%, with flags, width and
+precision; h/l length modifiers are accepted (all arguments are 32 bits).
+%s arguments must point into flash and are read from the ELF.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from elf32 import Elf32, MemoryImage, parse_dump_arg  # noqa: E402
+
+CONV_RE = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|l|z|t|j)?([diuxXocsp%])")
+
+RING_FIELDS = "<IIIII"  # runtime_ring_t: buf, elem_size, mask, head, tail
+
+
+class Formats:
+    def __init__(self, elf):
+        sec = elf.section(".log_fmt")
+        if sec is None:
+            raise ValueError("no .log_fmt section: built without RUNTIME_LOG?")
+        self.base = sec.addr
+        self.data = elf.data[sec.offset:sec.offset + sec.size]
+        self.elf = elf
+
+    def lookup(self, token):
+        off = token - self.base
+        if off < 0 or off >= len(self.data) or (off and self.data[off - 1] != 0):
+            return None
+        return self.data[off:].split(b"\0", 1)[0].decode("utf-8", "replace")
+
+
+def arg_count(fmt):
+    return sum(1 for m in CONV_RE.finditer(fmt) if m.group(5) != "%")
+
+
+def render(fmt, args, elf):
+    it = iter(args)
+
+    def one(m):
+        flags, width, prec, _length, conv = m.groups()
+        if conv == "%":
+            return "%"
+        v = next(it)
+        spec = "%" + flags + width + ("." + prec if prec else "")
+        if conv in "di":
+            return (spec + "d") % (v - (1 << 32) if v & 0x80000000 else v)
+        if conv == "u":
+            return (spec + "d") % v
+        if conv in "xXo":
+            return (spec + conv) % v
+        if conv == "c":
+            return (spec + "c") % chr(v & 0xFF)
+        if conv == "p":
+            return "0x%08x" % v
+        s = elf.read_cstr(v)
+        return (spec + "s") % (s if s is not None else "<str@0x%08x>" % v)
+
+    return CONV_RE.sub(one, fmt)
+
+
+def decode(words, formats):
+    """Yield one line per record; stops at a word that is not a token"""
+    i = 0
+    while i < len(words):
+        fmt = formats.lookup(words[i])
+        if fmt is None:
+            yield "<bad token 0x%08x at word %d, %d words left undecoded>" % (
+                words[i], i, len(words) - i)
+            return
+        n = arg_count(fmt)
+        args = words[i + 1:i + 1 + n]
+        if len(args) < n:
+            yield "<truncated record: %r>" % fmt
+            return
+        yield render(fmt, args, formats.elf)
+        i += 1 + n
+
+
+def ring_words(elf, mem):
+    sym = elf.symbol("g_log")
+    if sym is None:
+        raise ValueError("g_log not found in the ELF symbol table")
+    buf, elem_size, mask, head, tail = struct.unpack(
+        RING_FIELDS, mem.read(sym.value, struct.calcsize(RING_FIELDS)))
+    if elem_size != 4:
+        raise ValueError("g_log not initialised (elem_size %d)" % elem_size)
+    count = (head - tail) & 0xFFFFFFFF
+    if count > mask + 1:
+        raise ValueError("g_log head/tail inconsistent (%d words)" % count)
+    words = [mem.u32(buf + ((tail + i) & mask) * 4) for i in range(count)]
+
+    dropped = None
+    dsym = elf.symbol("g_log_dropped")
+    if dsym is not None:
+        try:
+            dropped = mem.u32(dsym.value)
+        except ValueError:
+            pass  # partial dump: the counter is optional
+    return words, dropped
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("elf", help="firmware ELF (build/blink.elf)")
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--dump", action="append", metavar="FILE[@ADDR]",
+                     help="RAM dump and its base address (default 0x20000000); repeatable")
+    src.add_argument("--stream", metavar="FILE",
+                     help="raw little-endian words from runtime_log_drain()")
+    args = ap.parse_args()
+
+    elf = Elf32(args.elf)
+    formats = Formats(elf)
+
+    dropped = None
+    if args.stream:
+        with open(args.stream, "rb") as f:
+            raw = f.read()
+        words = list(struct.unpack("<%dI" % (len(raw) // 4), raw[:len(raw) & ~3]))
+    else:
+        mem = MemoryImage()
+        for arg in args.dump:
+            path, base = parse_dump_arg(arg)
+            with open(path, "rb") as f:
+                mem.add(base, f.read())
+        words, dropped = ring_words(elf, mem)
+
+    for line in decode(words, formats):
+        print(line)
+    if dropped:
+        print("-- %d record(s) dropped (ring full)" % dropped, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""pcprof_report.py — flat profile from the g_pcprof PC histogram
+
+Reads g_pcprof (runtime_pcprof.h) out of a RAM dump and maps every bin
+back to functions through the ELF symbol table:
+
+    (gdb) dump binary memory ram.bin 0x20000000 0x2000C000
+    python3 tools/pcprof_report.py build/blink.elf --dump ram.bin
+
+A bin covers 2^shift bytes; when one straddles two functions its samples
+are split by the bytes each function owns in it. Time spent idle shows up
+in runtime_wait_event() at the WFE (the main event loop), or in
+runtime_idle() / tickless_wait() at the WFI.
+"""
+
+import argparse
+import bisect
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from elf32 import Elf32, MemoryImage, parse_dump_arg  # noqa: E402
+
+TEXT_BINS = 1024         # RUNTIME_PCPROF_TEXT_BINS
+HEADER = "<IIIIIIII"     # text {base, end, shift}, ram {base, end, shift}, samples, other
+
+
+def read_profile(elf, mem):
+    sym = elf.symbol("g_pcprof")
+    if sym is None:
+        raise ValueError("g_pcprof not in the ELF: build with make PCPROF=systick|timer")
+    hsize = struct.calcsize(HEADER)
+    (tbase, tend, tshift, rbase, rend, rshift,
+     samples, other) = struct.unpack(HEADER, mem.read(sym.value, hsize))
+    nbins = (sym.size - hsize) // 4
+    hist = struct.unpack("<%dI" % nbins, mem.read(sym.value + hsize, nbins * 4))
+    ranges = [(tbase, tend, tshift, hist[:TEXT_BINS]),
+              (rbase, rend, rshift, hist[TEXT_BINS:])]
+    return ranges, samples, other
+
+
+class Symbols:
+    def __init__(self, elf):
+        self.funcs = [f for f in elf.functions() if f.size > 0]
+        self.starts = [f.value for f in self.funcs]
+
+    def split(self, lo, hi):
+        """(name, bytes) for every function overlapping [lo, hi)"""
+        parts = []
+        i = max(bisect.bisect_right(self.starts, lo) - 1, 0)
+        covered = 0
+        while i < len(self.funcs) and self.funcs[i].value < hi:
+            f = self.funcs[i]
+            n = min(hi, f.value + f.size) - max(lo, f.value)
+            if n > 0:
+                parts.append((f.name, n))
+                covered += n
+            i += 1
+        if covered < hi - lo:
+            parts.append(("0x%08x (no symbol)" % lo, hi - lo - covered))
+        return parts
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("elf", help="firmware ELF built with make PCPROF=...")
+    ap.add_argument("--dump", action="append", required=True, metavar="FILE[@ADDR]",
+                    help="RAM dump and its base address (default 0x20000000); repeatable")
+    ap.add_argument("--top", type=int, default=0, help="show only the first N functions")
+    args = ap.parse_args()
+
+    elf = Elf32(args.elf)
+    mem = MemoryImage()
+    for arg in args.dump:
+        path, base = parse_dump_arg(arg)
+        with open(path, "rb") as f:
+            mem.add(base, f.read())
+
+    ranges, samples, other = read_profile(elf, mem)
+    syms = Symbols(elf)
+
+    per_func = {}
+    for base, end, shift, hist in ranges:
+        for i, count in enumerate(hist):
+            if count == 0:
+                continue
+            lo = base + (i << shift)
+            hi = min(lo + (1 << shift), end)
+            parts = syms.split(lo, hi)
+            total = sum(n for _, n in parts)
+            for name, n in parts:
+                per_func[name] = per_func.get(name, 0.0) + count * n / total
+
+    if samples == 0:
+        print("no samples yet (profiler not started?)")
+        return 1
+
+    rows = sorted(per_func.items(), key=lambda kv: -kv[1])
+    if args.top:
+        rows = rows[:args.top]
+
+    print("%d samples, bins of %d bytes (.text) / %d bytes (.ramfunc)"
+          % (samples, 1 << ranges[0][2], 1 << ranges[1][2]))
+    print()
+    print("%9s %7s  %s" % ("samples", "%", "function"))
+    for name, count in rows:
+        print("%9.1f %6.2f%%  %s" % (count, 100.0 * count / samples, name))
+    if other:
+        print("%9d %6.2f%%  <outside .text and .ramfunc>" % (other, 100.0 * other / samples))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,213 @@
+/* pool_bench.c — host checks and timing for runtime_pool.c (make pool-bench)
+ *
+ * The tool provides the arena that linker.ld reserves on the target;
+ * the Makefile places __pool_arena_end POOL_ARENA bytes after it.
+ *
+ * Checks: arena carving and exhaustion, size rounding and alignment,
+ * rejected frees, and a random alloc/free walk compared against a shadow
+ * ownership map (no block handed out twice, stats exact). Then ns per
+ * alloc + free pair and per block of a full drain / refill, next to the
+ * host malloc/free for scale.
+ *
+ *   $ make pool-bench
+ */
+
+#define _POSIX_C_SOURCE 199309L   /* clock_gettime */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "runtime_pool.h"
+
+#ifndef POOL_ARENA
+#define POOL_ARENA  (4096u)
+#endif
+
+_Alignas(8) uint8_t __pool_arena_start[POOL_ARENA];
+
+#define WALK_STEPS  (1000000u)
+#define TIME_ROUNDS (2000000u)
+
+static int s_fail;
+
+#define CHECK(cond)                                                    \
+    do {                                                               \
+        if (!(cond)) {                                                 \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            s_fail = 1;                                                \
+        }                                                              \
+    } while (0)
+
+static uint32_t s_rng = 0x2545F491u;
+
+static uint32_t rnd(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* Random walk: every block owned at most once, stats follow the shadow */
+static void walk(runtime_pool_t *pool)
+{
+    static void    *held[POOL_ARENA / 8u];
+    static uint8_t  owned[POOL_ARENA / 8u];
+    uint32_t        n = 0;
+    uint32_t        high = pool->high_water;
+    uint32_t        failed = pool->failed;
+
+    for (uint32_t step = 0; step < WALK_STEPS; step++) {
+        if ((n != 0u) && ((rnd() % 2u) == 0u)) {
+            uint32_t  i   = rnd() % n;
+            void     *blk = held[i];
+            uint32_t  idx = (uint32_t)((uint8_t *)blk - pool->base) / pool->block_size;
+
+            CHECK(runtime_pool_free(pool, blk) == 0);
+            owned[idx] = 0;
+            held[i] = held[--n];
+        } else {
+            void *blk = runtime_pool_alloc(pool);
+
+            if (n == pool->count) {
+                CHECK(blk == NULL);
+                failed++;
+                continue;
+            }
+            CHECK(blk != NULL);
+            if (blk == NULL) {
+                return;
+            }
+
+            uint32_t idx = (uint32_t)((uint8_t *)blk - pool->base) / pool->block_size;
+            CHECK(((uintptr_t)blk & 7u) == 0u);
+            CHECK((uint8_t *)blk >= pool->base && (uint8_t *)blk < pool->end);
+            CHECK(owned[idx] == 0u);
+            owned[idx] = 1;
+            held[n++] = blk;
+            if (n > high) {
+                high = n;
+            }
+        }
+        CHECK(pool->used == n);
+    }
+    CHECK(pool->high_water == high);
+    CHECK(pool->failed == failed);
+
+    while (n != 0u) {
+        void *blk = held[--n];
+
+        owned[(uint32_t)((uint8_t *)blk - pool->base) / pool->block_size] = 0;
+        CHECK(runtime_pool_free(pool, blk) == 0);
+    }
+    CHECK(pool->used == 0u);
+}
+
+static void time_pool(runtime_pool_t *pool)
+{
+    static void *held[POOL_ARENA / 8u];
+    double       t0;
+    double       t1;
+    double       t2;
+    double       t3;
+    uint32_t     rounds = TIME_ROUNDS / pool->count;
+
+    t0 = now_ns();
+    for (uint32_t r = 0; r < TIME_ROUNDS; r++) {
+        void *blk = runtime_pool_alloc(pool);
+        __asm__ volatile ("" : : "r" (blk) : "memory");
+        runtime_pool_free(pool, blk);
+    }
+    t1 = now_ns();
+
+    double drain = 0.0;
+    double fill  = 0.0;
+    for (uint32_t r = 0; r < rounds; r++) {
+        t2 = now_ns();
+        for (uint32_t i = 0; i < pool->count; i++) {
+            held[i] = runtime_pool_alloc(pool);
+        }
+        t3 = now_ns();
+        for (uint32_t i = 0; i < pool->count; i++) {
+            runtime_pool_free(pool, held[i]);
+        }
+        drain += t3 - t2;
+        fill  += now_ns() - t3;
+    }
+
+    double m0 = now_ns();
+    for (uint32_t r = 0; r < TIME_ROUNDS; r++) {
+        void *blk = malloc(pool->block_size);
+        __asm__ volatile ("" : : "r" (blk) : "memory");
+        free(blk);
+    }
+    double m1 = now_ns();
+
+    printf("%-6s %4u x %3u B: pair %.2f ns, drain %.2f ns/blk, refill %.2f ns/blk"
+           " (malloc+free %.2f ns)\n",
+           pool->name, (unsigned)pool->count, (unsigned)pool->block_size,
+           (t1 - t0) / TIME_ROUNDS, drain / ((double)rounds * pool->count),
+           fill / ((double)rounds * pool->count), (m1 - m0) / TIME_ROUNDS);
+}
+
+int main(void)
+{
+    static runtime_pool_t small;
+    static runtime_pool_t big;
+    static runtime_pool_t none;
+    uint8_t               local;
+
+    /* Carving: sizes round up to 8, pools sit back to back */
+    CHECK(runtime_pool_init(&small, "small", 13u, 64u) == 0);
+    CHECK(small.block_size == 16u);
+    CHECK(small.base == __pool_arena_start);
+    CHECK(runtime_pool_init(&big, "big", 64u, 32u) == 0);
+    CHECK(big.base == small.end);
+    CHECK(runtime_pool_arena_free() == POOL_ARENA - 64u * 16u - 32u * 64u);
+
+    /* Too big for what is left: refused, pool stays empty, arena untouched */
+    uint32_t left = runtime_pool_arena_free();
+    CHECK(runtime_pool_init(&none, "none", 8u, left / 8u + 1u) == -1);
+    CHECK(runtime_pool_alloc(&none) == NULL);
+    CHECK(runtime_pool_arena_free() == left);
+
+    /* First blocks come out in address order */
+    void *a = runtime_pool_alloc(&small);
+    void *b = runtime_pool_alloc(&small);
+    CHECK(a == small.base);
+    CHECK(b == small.base + 16);
+
+    /* Frees that are not block starts of this pool are refused */
+    CHECK(runtime_pool_free(&small, (uint8_t *)a + 4) == -1);
+    CHECK(runtime_pool_free(&small, big.base) == -1);
+    CHECK(runtime_pool_free(&small, &local) == -1);
+    CHECK(runtime_pool_free(&big, a) == -1);
+    CHECK(small.used == 2u);
+    CHECK(runtime_pool_free(&small, b) == 0);
+    CHECK(runtime_pool_free(&small, a) == 0);
+    CHECK(runtime_pool_alloc(&small) == a);     /* LIFO: last freed first */
+    CHECK(runtime_pool_free(&small, a) == 0);
+
+    walk(&small);
+    walk(&big);
+
+    if (s_fail) {
+        return 1;
+    }
+    printf("ok: carving, rounding, rejected frees, %u-step walks\n",
+           (unsigned)WALK_STEPS);
+
+    time_pool(&small);
+    time_pool(&big);
+    return 0;
+}
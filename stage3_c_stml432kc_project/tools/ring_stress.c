@@ -0,0 +1,286 @@
+/* ring_stress.c — host stress and throughput test for runtime_ring.h
+ *                  (make ring-stress)
+ *
+ * First, single-threaded edge cases: a full ring holds all `capacity`
+ * elements, spans stop at the wrap point, pop_batch() copies across it,
+ * and counters wrap past 2^32.
+ *
+ * Then a producer thread and a consumer thread stream a numbered
+ * sequence through a small ring (many wraps) in three shapes. Each
+ * element carries its sequence number and a check word, so a lost,
+ * repeated, reordered or torn element is caught:
+ *
+ *   single : push() / pop()
+ *   span   : reserve/commit / peek/release, random span lengths
+ *   batch  : reserve/commit / pop_batch(), random batch sizes
+ *
+ * A side that finds the ring full or empty yields the CPU, so this also
+ * runs on a single core. The acquire/release pairs in runtime_ring.h keep
+ * the element data ordered on a weakly ordered host, as the DMB does on
+ * target.
+ *
+ *   $ make ring-stress RING_STRESS_ELEMS=100000000
+ */
+
+#define _POSIX_C_SOURCE 200809L   /* clock_gettime, sched_yield */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "runtime_ring.h"
+
+#define RING_CAP   (64u)
+#define SPAN_MAX   (24u)
+
+typedef struct {
+    uint32_t seq;
+    uint32_t check;
+    uint32_t pad;      /* 12-byte elements: not a power of two */
+} elem_t;
+
+static uint32_t elem_check(uint32_t seq)
+{
+    return (seq * 0x9E3779B1u) ^ 0xA5A5A5A5u;
+}
+
+static int s_fail;
+
+#define CHECK(cond)                                                    \
+    do {                                                               \
+        if (!(cond)) {                                                 \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            s_fail = 1;                                                \
+        }                                                              \
+    } while (0)
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Per-thread xorshift */
+static uint32_t rnd(uint32_t *s)
+{
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+/* ============================
+   Edge cases (one thread)
+   ============================ */
+
+static void check_edges(void)
+{
+    RUNTIME_RING_STORAGE(storage, uint32_t, 8u);
+    runtime_ring_t r;
+    uint32_t       v;
+    uint32_t       granted;
+    uint32_t       avail;
+    uint32_t       out[8];
+
+    runtime_ring_init(&r, storage, sizeof(uint32_t), 8u);
+    CHECK(runtime_ring_capacity(&r) == 8u);
+    CHECK(runtime_ring_pop(&r, &v) == 0);
+
+    /* Full means all eight slots */
+    for (uint32_t i = 0; i < 8u; i++) {
+        CHECK(runtime_ring_push(&r, &i) == 1);
+    }
+    CHECK(runtime_ring_push(&r, &v) == 0);
+    CHECK(runtime_ring_free(&r) == 0u);
+    CHECK(runtime_ring_count(&r) == 8u);
+    for (uint32_t i = 0; i < 8u; i++) {
+        CHECK((runtime_ring_pop(&r, &v) == 1) && (v == i));
+    }
+
+    /* head = tail = 6: a span of 5 is cut at the wrap point (2 slots) */
+    runtime_ring_init(&r, storage, sizeof(uint32_t), 8u);
+    r.head = r.tail = 6u;
+    uint32_t *w = runtime_ring_reserve(&r, 5u, &granted);
+    CHECK((granted == 2u) && (w == &storage[6]));
+    w[0] = 100u;
+    w[1] = 101u;
+    runtime_ring_commit(&r, 2u);
+    w = runtime_ring_reserve(&r, 5u, &granted);
+    CHECK((granted == 5u) && (w == &storage[0]));
+    for (uint32_t i = 0; i < 5u; i++) {
+        w[i] = 102u + i;
+    }
+    runtime_ring_commit(&r, 5u);
+
+    const uint32_t *p = runtime_ring_peek(&r, &avail);
+    CHECK((avail == 2u) && (p == &storage[6]));
+
+    /* pop_batch() copies across the wrap in one release */
+    CHECK(runtime_ring_pop_batch(&r, out, 8u) == 7u);
+    for (uint32_t i = 0; i < 7u; i++) {
+        CHECK(out[i] == 100u + i);
+    }
+    CHECK(runtime_ring_count(&r) == 0u);
+
+    /* Free-running counters wrap past 2^32 */
+    r.head = r.tail = UINT32_MAX - 2u;
+    for (uint32_t i = 0; i < 8u; i++) {
+        CHECK(runtime_ring_push(&r, &i) == 1);
+    }
+    CHECK((runtime_ring_free(&r) == 0u) && (runtime_ring_count(&r) == 8u));
+    CHECK(runtime_ring_pop_batch(&r, out, 3u) == 3u);
+    CHECK((out[0] == 0u) && (out[2] == 2u));
+    CHECK(runtime_ring_pop_batch(&r, out, 8u) == 5u);
+    CHECK((out[0] == 3u) && (out[4] == 7u));
+}
+
+/* ============================
+   Producer / consumer threads
+   ============================ */
+
+enum { SHAPE_SINGLE, SHAPE_SPAN, SHAPE_BATCH, SHAPE_COUNT };
+static const char *const s_shape_name[SHAPE_COUNT] = { "single", "span", "batch" };
+
+RUNTIME_RING_STORAGE(s_storage, elem_t, RING_CAP);
+static runtime_ring_t s_ring;
+static uint32_t       s_elems;
+static uint32_t       s_shape;
+static uint32_t       s_bad;      /* consumer only */
+
+static void *producer(void *arg)
+{
+    uint32_t seed = 0x1234567u;
+    uint32_t seq  = 0;
+
+    (void)arg;
+    while (seq < s_elems) {
+        if (s_shape == SHAPE_SINGLE) {
+            elem_t e = { seq, elem_check(seq), 0u };
+            if (runtime_ring_push(&s_ring, &e)) {
+                seq++;
+            } else {
+                sched_yield();
+            }
+            continue;
+        }
+
+        uint32_t granted;
+        uint32_t want = 1u + rnd(&seed) % SPAN_MAX;
+        elem_t  *span = runtime_ring_reserve(&s_ring, want, &granted);
+
+        if (granted > s_elems - seq) {
+            granted = s_elems - seq;
+        }
+        for (uint32_t i = 0; i < granted; i++, seq++) {
+            span[i].seq   = seq;
+            span[i].check = elem_check(seq);
+        }
+        if (granted != 0u) {
+            runtime_ring_commit(&s_ring, granted);
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void expect(uint32_t *next, const elem_t *e)
+{
+    if ((e->seq != *next) || (e->check != elem_check(*next))) {
+        if (s_bad++ == 0u) {
+            printf("FAIL %s: got seq %u, expected %u\n", s_shape_name[s_shape],
+                   (unsigned)e->seq, (unsigned)*next);
+        }
+    }
+    (*next)++;
+}
+
+static void *consumer(void *arg)
+{
+    static elem_t batch[SPAN_MAX];
+    uint32_t      seed = 0x7654321u;
+    uint32_t      next = 0;
+
+    (void)arg;
+    while (next < s_elems) {
+        if (s_shape == SHAPE_SINGLE) {
+            elem_t e;
+            if (runtime_ring_pop(&s_ring, &e)) {
+                expect(&next, &e);
+            } else {
+                sched_yield();
+            }
+        } else if (s_shape == SHAPE_SPAN) {
+            uint32_t      avail;
+            uint32_t      max  = 1u + rnd(&seed) % SPAN_MAX;
+            const elem_t *span = runtime_ring_peek(&s_ring, &avail);
+
+            if (avail > max) {
+                avail = max;
+            }
+            for (uint32_t i = 0; i < avail; i++) {
+                expect(&next, &span[i]);
+            }
+            if (avail != 0u) {
+                runtime_ring_release(&s_ring, avail);
+            } else {
+                sched_yield();
+            }
+        } else {
+            uint32_t n = runtime_ring_pop_batch(&s_ring, batch, 1u + rnd(&seed) % SPAN_MAX);
+            for (uint32_t i = 0; i < n; i++) {
+                expect(&next, &batch[i]);
+            }
+            if (n == 0u) {
+                sched_yield();
+            }
+        }
+    }
+    return NULL;
+}
+
+static void run_shape(uint32_t shape)
+{
+    pthread_t prod;
+    pthread_t cons;
+    double    t0;
+    double    t1;
+
+    runtime_ring_init(&s_ring, s_storage, sizeof(elem_t), RING_CAP);
+    s_shape = shape;
+    s_bad   = 0;
+
+    t0 = now_s();
+    pthread_create(&cons, NULL, consumer, NULL);
+    pthread_create(&prod, NULL, producer, NULL);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    t1 = now_s();
+
+    CHECK(s_bad == 0u);
+    CHECK(runtime_ring_count(&s_ring) == 0u);
+    printf("%-6s %u elements of %u B through %u slots: %.1f M elements/s, %u errors\n",
+           s_shape_name[shape], (unsigned)s_elems, (unsigned)sizeof(elem_t),
+           (unsigned)RING_CAP, (double)s_elems / (t1 - t0) * 1e-6, (unsigned)s_bad);
+}
+
+int main(int argc, char **argv)
+{
+    s_elems = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 10000000u;
+
+    check_edges();
+    if (s_fail) {
+        return 1;
+    }
+    printf("ok: full ring, wrap-point spans, pop_batch across the wrap, counter wrap\n");
+
+    for (uint32_t shape = 0; shape < SHAPE_COUNT; shape++) {
+        run_shape(shape);
+    }
+    return s_fail;
+}
@@ -0,0 +1,248 @@
+#!/usr/bin/env python3
+"""rtt_read.py — read the runtime_rtt channels without halting the target
+
+Finds the g_rtt control block (ELF symbol, or a scan of RAM for the
+"SEGGER RTT" id), then drains up channels and feeds the down channel
+through OpenOCD's TCL port (6666) with read_memory / write_memory while
+the core keeps running:
+
+    openocd -f openocd_l432_stlink.cfg                   (in another shell)
+    python3 tools/rtt_read.py --elf build/blink.elf      (channel 0 to stdout)
+    python3 tools/rtt_read.py --channel 1 --out log.bin  (runtime_log words)
+    python3 tools/log_decode.py build/blink.elf --stream log.bin
+
+Or once, offline, from a RAM image (nothing is acknowledged):
+
+    (gdb) dump binary memory ram.bin 0x20000000 0x2000C000
+    python3 tools/rtt_read.py --dump ram.bin --list
+"""
+
+import argparse
+import os
+import socket
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from elf32 import Elf32, MemoryImage, parse_dump_arg  # noqa: E402
+
+RTT_ID = b"SEGGER RTT\0"
+CB_HEADER = "<16sii"     # id, max_up, max_down
+BUF_DESC = "<IIIIII"     # name, buf, size, wr, rd, flags
+BUF_DESC_SIZE = struct.calcsize(BUF_DESC)
+WR_OFFSET = 12
+RD_OFFSET = 16
+
+RAM_BASE = 0x20000000
+RAM_SIZE = 0xC000
+
+
+class OpenOcd:
+    """Memory access over OpenOCD's TCL RPC (commands end with 0x1a)"""
+
+    def __init__(self, host, port):
+        self.sock = socket.create_connection((host, port))
+
+    def cmd(self, text):
+        self.sock.sendall(text.encode() + b"\x1a")
+        reply = b""
+        while not reply.endswith(b"\x1a"):
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise ConnectionError("OpenOCD closed the connection")
+            reply += chunk
+        return reply[:-1].decode()
+
+    def read(self, addr, size):
+        reply = self.cmd("read_memory 0x%08x 8 %d" % (addr, size))
+        try:
+            data = bytes(int(v, 0) for v in reply.split())
+        except ValueError:
+            raise IOError("read_memory 0x%08x: %s" % (addr, reply.strip()))
+        if len(data) != size:
+            raise IOError("read_memory 0x%08x: short read" % addr)
+        return data
+
+    def u32(self, addr):
+        return struct.unpack("<I", self.read(addr, 4))[0]
+
+    def write(self, addr, data):
+        values = " ".join("0x%02x" % b for b in data)
+        self.cmd("write_memory 0x%08x 8 {%s}" % (addr, values))
+
+    def write_u32(self, addr, value):
+        self.cmd("write_memory 0x%08x 32 {0x%08x}" % (addr, value))
+
+
+class Dump(MemoryImage):
+    """A RAM image: read-only, so the reader indices are never advanced"""
+
+    def write(self, addr, data):
+        pass
+
+    def write_u32(self, addr, value):
+        pass
+
+
+class Channel:
+    def __init__(self, target, desc_addr, elf=None):
+        self.target = target
+        self.elf = elf
+        self.desc = desc_addr
+        name, self.buf, self.size, _wr, _rd, self.flags = struct.unpack(
+            BUF_DESC, target.read(desc_addr, BUF_DESC_SIZE))
+        self.name = self._cstr(name)
+
+    def _cstr(self, addr):
+        if addr == 0:
+            return ""
+        try:
+            # Names are string literals: in flash, or absent from a RAM dump
+            return self.target.read(addr, 16).split(b"\0", 1)[0].decode("ascii", "replace")
+        except (IOError, ValueError):
+            name = self.elf.read_cstr(addr, 16) if self.elf else None
+            return name if name is not None else "@0x%08x" % addr
+
+    def indices(self):
+        wr, rd = struct.unpack("<II", self.target.read(self.desc + WR_OFFSET, 8))
+        if wr >= self.size or rd >= self.size:
+            raise ValueError("channel %r: bad indices wr=%d rd=%d" % (self.name, wr, rd))
+        return wr, rd
+
+    def drain(self):
+        """Up channel: everything between rd and wr, then hand it back"""
+        wr, rd = self.indices()
+        if wr == rd:
+            return b""
+        if wr > rd:
+            data = self.target.read(self.buf + rd, wr - rd)
+        else:
+            data = self.target.read(self.buf + rd, self.size - rd)
+            if wr:
+                data += self.target.read(self.buf, wr)
+        self.target.write_u32(self.desc + RD_OFFSET, wr)
+        return data
+
+    def feed(self, data):
+        """Down channel: write what fits, return the count"""
+        wr, rd = self.indices()
+        free = (rd - wr - 1) % self.size
+        data = data[:free]
+        first = data[:self.size - wr]
+        if first:
+            self.target.write(self.buf + wr, first)
+        if len(data) > len(first):
+            self.target.write(self.buf, data[len(first):])
+        self.target.write_u32(self.desc + WR_OFFSET, (wr + len(data)) % self.size)
+        return len(data)
+
+
+def find_cb(target, elf, base, size):
+    if elf is not None:
+        sym = elf.symbol("g_rtt")
+        if sym is not None:
+            return sym.value
+    chunk = 1024
+    for addr in range(base, base + size, chunk):
+        # Overlap chunks so an id across the boundary is still found
+        n = min(chunk + len(RTT_ID), base + size - addr)
+        try:
+            pos = target.read(addr, n).find(RTT_ID)
+        except (IOError, ValueError):
+            continue
+        if pos >= 0:
+            return addr + pos
+    return None
+
+
+def open_cb(target, addr, elf=None):
+    ident, max_up, max_down = struct.unpack(
+        CB_HEADER, target.read(addr, struct.calcsize(CB_HEADER)))
+    if not ident.startswith(RTT_ID):
+        raise ValueError("no RTT id at 0x%08x (runtime_rtt_init() not run yet?)" % addr)
+    desc = addr + struct.calcsize(CB_HEADER)
+    up = [Channel(target, desc + i * BUF_DESC_SIZE, elf) for i in range(max_up)]
+    desc += max_up * BUF_DESC_SIZE
+    down = [Channel(target, desc + i * BUF_DESC_SIZE, elf) for i in range(max_down)]
+    return up, down
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--elf", help="firmware ELF: locate g_rtt by symbol instead of scanning")
+    ap.add_argument("--dump", action="append", metavar="FILE[@ADDR]",
+                    help="read a RAM image instead of a live target; repeatable")
+    ap.add_argument("--host", default="localhost")
+    ap.add_argument("--port", type=int, default=6666, help="OpenOCD TCL port")
+    ap.add_argument("--scan", default="0x%08x:0x%x" % (RAM_BASE, RAM_SIZE),
+                    metavar="ADDR:SIZE", help="RAM range searched for the id")
+    ap.add_argument("--channel", type=int, default=0, help="up channel to read")
+    ap.add_argument("--out", help="write the channel bytes to a file, not stdout")
+    ap.add_argument("--send", help="text for down channel 0 (a newline is added)")
+    ap.add_argument("--list", action="store_true", help="print the channels and exit")
+    ap.add_argument("--once", action="store_true", help="drain once and exit")
+    ap.add_argument("--interval", type=float, default=0.05, help="poll period, seconds")
+    args = ap.parse_args()
+
+    if args.dump and args.send is not None:
+        ap.error("--send needs a live target")
+
+    elf = Elf32(args.elf) if args.elf else None
+    if args.dump:
+        target = Dump()
+        for arg in args.dump:
+            path, base = parse_dump_arg(arg)
+            with open(path, "rb") as f:
+                target.add(base, f.read())
+        args.once = True
+    else:
+        target = OpenOcd(args.host, args.port)
+
+    scan_base, scan_size = (int(v, 0) for v in args.scan.split(":"))
+    addr = find_cb(target, elf, scan_base, scan_size)
+    if addr is None:
+        print("no RTT control block found", file=sys.stderr)
+        return 1
+    up, down = open_cb(target, addr, elf)
+
+    if args.list:
+        print("g_rtt at 0x%08x" % addr)
+        for kind, chans in (("up", up), ("down", down)):
+            for i, ch in enumerate(chans):
+                wr, rd = ch.indices()
+                print("%-4s %d  %-10s buf 0x%08x  size %5d  pending %d"
+                      % (kind, i, ch.name, ch.buf, ch.size, (wr - rd) % ch.size))
+        return 0
+
+    if args.send is not None:
+        data = args.send.encode() + b"\n"
+        while data:
+            data = data[down[0].feed(data):]
+            if data:
+                time.sleep(args.interval)
+
+    if args.channel >= len(up):
+        print("no up channel %d" % args.channel, file=sys.stderr)
+        return 1
+    chan = up[args.channel]
+    out = open(args.out, "ab") if args.out else sys.stdout.buffer
+    try:
+        while True:
+            data = chan.drain()
+            if data:
+                out.write(data)
+                out.flush()
+            if args.once:
+                break
+            time.sleep(args.interval)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if args.out:
+            out.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
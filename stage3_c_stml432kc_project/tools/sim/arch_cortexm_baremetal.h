@@ -0,0 +1,112 @@
+/* arch_cortexm_baremetal.h — host stand-in for the tools/ simulations
+ *
+ * Force-included (-include) ahead of everything: it takes the real
+ * header's include guard, so runtime.c and runtime_timer.c build
+ * unchanged on the host. Register accesses go to sim_reg(), and PRIMASK,
+ * WFI and WFE to the sim_* hooks below; the tool linking against them
+ * supplies the model (tools/tickless_sim.c has the SysTick one). Only
+ * what those two files use is provided.
+ */
+
+#ifndef ARCH_CORTEXM_BAREMETAL_H
+#define ARCH_CORTEXM_BAREMETAL_H
+
+#include <stdint.h>
+
+/* ============================
+   Model hooks (provided by the tool)
+   ============================ */
+volatile uint32_t *sim_reg(uint32_t addr);
+uint32_t           sim_cyccnt(void);
+void               sim_unmasked(void);   /* PRIMASK just cleared */
+void               sim_wfi(void);
+void               sim_wfe(void);
+void               sim_sev(void);
+
+extern uint32_t sim_primask;
+extern uint32_t sim_ipsr;
+
+/* Architecture-level register accessor */
+#define REG32(addr) (*sim_reg(addr))
+
+/* ============================
+   SysTick (Cortex-M)
+   ============================ */
+#define SYST_CSR           REG32(0xE000E010u)
+#define SYST_RVR           REG32(0xE000E014u)
+#define SYST_CVR           REG32(0xE000E018u)
+
+#define SYST_CSR_ENABLE    (1u << 0)
+#define SYST_CSR_TICKINT   (1u << 1)
+#define SYST_CSR_CLKSOURCE (1u << 2)
+
+#define SYST_RVR_MAX       (0x00FFFFFFu)
+
+/* ============================
+   SCB (Cortex-M)
+   ============================ */
+#define SCB_ICSR           REG32(0xE000ED04u)
+
+#define SCB_ICSR_PENDSTCLR (1u << 25)
+#define SCB_ICSR_PENDSTSET (1u << 26)
+
+/* ============================
+   DWT cycle counter, IRQ control, sleep
+   ============================ */
+static inline void arch_cyccnt_enable(void)
+{
+}
+
+static inline uint32_t arch_cyccnt(void)
+{
+    return sim_cyccnt();
+}
+
+static inline void arch_irq_disable(void)
+{
+    sim_primask = 1u;
+}
+
+static inline void arch_irq_enable(void)
+{
+    sim_primask = 0u;
+    sim_unmasked();
+}
+
+static inline uint32_t arch_irq_save(void)
+{
+    uint32_t primask = sim_primask;
+
+    sim_primask = 1u;
+    return primask;
+}
+
+static inline void arch_irq_restore(uint32_t primask)
+{
+    sim_primask = primask;
+    if (primask == 0u) {
+        sim_unmasked();
+    }
+}
+
+static inline uint32_t arch_ipsr(void)
+{
+    return sim_ipsr;
+}
+
+static inline void arch_wfi(void)
+{
+    sim_wfi();
+}
+
+static inline void arch_wfe(void)
+{
+    sim_wfe();
+}
+
+static inline void arch_sev(void)
+{
+    sim_sev();
+}
+
+#endif /* ARCH_CORTEXM_BAREMETAL_H */
@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""stack_report.py — worst-case stack depth from GCC call-graph files
+
+Reads the .ci files GCC writes with -fstack-usage -fcallgraph-info=su
+(one per object, next to the .o) and walks every call chain:
+
+    python3 tools/stack_report.py --ld linker.ld build/*.ci
+
+For each root (main, every *_Handler, and any function nothing calls,
+e.g. task entries and callbacks) it prints the deepest chain and its
+bytes. Exception handlers also pay the hardware frame: 32 bytes, or
+104 with a lazily stacked FP context.
+
+Limits, all flagged in the report:
+  - assembly functions have no .ci; their frames come from ASM_FRAMES
+  - libgcc helpers (__aeabi_*, ...) have no .ci either; counted as 0
+  - indirect calls (function pointers) are not followed
+  - recursion makes the depth unbounded
+  - "dynamic" frames (alloca/VLA) are counted at their bounded size only
+"""
+
+import argparse
+import re
+import sys
+
+# Frames of the hand-written assembly routines (bytes pushed on the stack)
+ASM_FRAMES = {
+    "Reset_Handler": 0,
+    "Default_Handler": 0,
+    "startup_region_copy": 28,  # push {r4-r10}
+    "startup_region_zero": 8,   # push {r4-r5}
+    "startup_region_fill": 8,
+    "PendSV_Handler": 0,        # saves onto the outgoing task's PSP
+    "runtime_pcprof_systick_entry": 8,  # push {r3, lr}
+    "runtime_pcprof_timer_entry": 0,    # tail-calls into C
+}
+
+EXC_FRAME_BASIC = 32
+EXC_FRAME_FP = 104
+
+NODE_RE = re.compile(r'node:\s*\{\s*title:\s*"([^"]+)"\s*label:\s*"([^"]*)"')
+EDGE_RE = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]+)"\s*targetname:\s*"([^"]+)"')
+SIZE_RE = re.compile(r'(\d+) bytes \(([^)]*)\)')
+INDIRECT = "__indirect_call"
+
+
+class Func:
+    def __init__(self, title, name):
+        self.title = title
+        self.name = name
+        self.frame = None       # None: declared only (defined elsewhere)
+        self.qualifier = ""
+        self.calls = []
+        self.indirect = False
+
+
+def load(paths):
+    funcs = {}
+    for path in paths:
+        with open(path) as f:
+            text = f.read()
+        for title, label in NODE_RE.findall(text):
+            name = label.split("\\n")[0]
+            fn = funcs.setdefault(title, Func(title, name))
+            m = SIZE_RE.search(label)
+            if m:
+                fn.frame = int(m.group(1))
+                fn.qualifier = m.group(2)
+        for src, dst in EDGE_RE.findall(text):
+            fn = funcs.setdefault(src, Func(src, src.split(":")[-1]))
+            if dst == INDIRECT:
+                fn.indirect = True
+            else:
+                fn.calls.append(dst)
+
+    for name, frame in ASM_FRAMES.items():
+        fn = funcs.setdefault(name, Func(name, name))
+        if fn.frame is None:
+            fn.frame = frame
+            fn.qualifier = "asm"
+    return funcs
+
+
+class Walker:
+    def __init__(self, funcs):
+        self.funcs = funcs
+        self.memo = {}
+        self.active = set()
+
+    def depth(self, title):
+        """(bytes, chain, flags) for the deepest path starting at title"""
+        if title in self.memo:
+            return self.memo[title]
+        fn = self.funcs.get(title)
+        if fn is None or fn.frame is None:
+            return 0, [title], {"libgcc" if title.startswith("__") else "unknown"}
+        if title in self.active:
+            return 0, [title], {"recursive"}
+
+        self.active.add(title)
+        best = (0, [], set())
+        flags = set()
+        for callee in fn.calls:
+            d = self.depth(callee)
+            flags |= d[2]
+            if d[0] > best[0] or not best[1]:
+                best = d
+        self.active.discard(title)
+
+        if fn.indirect:
+            flags.add("indirect")
+        if "dynamic" in fn.qualifier and "bounded" not in fn.qualifier:
+            flags.add("dynamic")
+
+        result = (fn.frame + best[0], [fn.name] + best[1], flags)
+        self.memo[title] = result
+        return result
+
+
+def stack_reservation(ld_path):
+    with open(ld_path) as f:
+        m = re.search(r"_stack_size\s*=\s*(0x[0-9a-fA-F]+|\d+)", f.read())
+    return int(m.group(1), 0) if m else None
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("ci", nargs="+", help=".ci files from -fcallgraph-info=su")
+    ap.add_argument("--ld", help="linker script, to compare against _stack_size")
+    ap.add_argument("--fp", action="store_true",
+                    help="charge handlers the 104-byte FP exception frame")
+    args = ap.parse_args()
+
+    funcs = load(args.ci)
+    walker = Walker(funcs)
+
+    called = {c for fn in funcs.values() for c in fn.calls}
+    roots = [t for t, fn in funcs.items()
+             if fn.frame is not None and (t not in called or fn.name == "main"
+                                          or fn.name.endswith("_Handler"))]
+
+    exc = EXC_FRAME_FP if args.fp else EXC_FRAME_BASIC
+    rows = []
+    for title in roots:
+        fn = funcs[title]
+        total, chain, flags = walker.depth(title)
+        handler = fn.name.endswith("_Handler") and fn.name != "Reset_Handler"
+        if handler:
+            total += exc
+        rows.append((total, fn.name, handler, chain, flags))
+    rows.sort(key=lambda r: (-r[0], r[1]))
+
+    print("%-8s %-28s %s" % ("bytes", "root", "deepest chain"))
+    for total, name, handler, chain, flags in rows:
+        note = " [%s]" % ",".join(sorted(flags)) if flags else ""
+        kind = " (+%d exc frame)" % exc if handler else ""
+        print("%-8d %-28s %s%s%s" % (total, name, " > ".join(chain), kind, note))
+
+    # Main stack budget: deepest thread chain plus every handler nested once
+    # (conservative: assumes each one can preempt the next).
+    thread = max((r[0] for r in rows if r[1] == "main"), default=0)
+    handlers = sum(r[0] for r in rows if r[2])
+    print()
+    print("main worst case            : %d bytes" % thread)
+    print("handlers, all nested       : %d bytes" % handlers)
+    print("main stack worst case      : %d bytes" % (thread + handlers))
+
+    if args.ld:
+        reserved = stack_reservation(args.ld)
+        if reserved:
+            print("reserved (_stack_size)     : %d bytes, %d headroom"
+                  % (reserved, reserved - thread - handlers))
+
+    if any(r[4] for r in rows):
+        print()
+        print("flags: indirect = calls through pointers not followed, "
+              "recursive = unbounded, libgcc/unknown = no frame info (0 assumed)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
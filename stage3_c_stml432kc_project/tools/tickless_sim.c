@@ -0,0 +1,551 @@
+/* tickless_sim.c — runtime.c timebase against a simulated SysTick
+ *                  (make tickless-sim)
+ *
+ * runtime.c and runtime_timer.c are built unchanged for the host, over
+ * tools/sim/arch_cortexm_baremetal.h. This file is the other side of that
+ * header: a count-accurate SysTick (CVR counts down, reloads from RVR on
+ * the count after 0, pends PENDSTSET on reaching 0, a CVR write clears
+ * it), PRIMASK, exception entry, WFI/WFE, and one external interrupt the
+ * scenarios schedule at a chosen count.
+ *
+ * Register writes take no time. A read takes none either, unless it
+ * repeats the previous access (a polling loop: one count per read), or
+ * a stride is set (that many counts per access, so SysTick_Handler can
+ * preempt a reader between any two of its register reads).
+ *
+ * Checked for several SYSCLK values:
+ *
+ *   delay    : runtime_delay_ms(d) returns d ms later, on few wake-ups
+ *   wrap     : reads from an ISR stepping count by count through wraps,
+ *              1 ms into a stretch and a stretch back into 1 ms
+ *   preempt  : thread reads with SysTick_Handler landing between them
+ *   timers   : one-shots armed from an ISR (and chained from callbacks)
+ *              while SysTick is stretched fire on their deadline
+ *
+ * Every read of runtime_micros64() must equal the counts elapsed since
+ * runtime_init() (no drift), and never go backwards.
+ *
+ *   $ make tickless-sim TICKLESS_SIM_ROUNDS=20000
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arch_cortexm_baremetal.h"
+#include "runtime.h"
+#include "runtime_timer.h"
+
+#define ADDR_CSR   (0xE000E010u)
+#define ADDR_RVR   (0xE000E014u)
+#define ADDR_CVR   (0xE000E018u)
+#define ADDR_ICSR  (0xE000ED04u)
+
+#define EXC_ENTRY_COUNTS  (12u)    /* Cortex-M4 exception entry */
+
+/* TICKLESS_MARGIN in runtime.c, plus the counts the arming path takes: a
+ * timer armed closer than this to its deadline may wake 1 ms later
+ */
+#define DEADLINE_SLACK    (64u + 8u)
+
+void SysTick_Handler(void);
+extern volatile uint32_t g_systick_ms;
+
+static int s_fail;
+
+#define CHECK(cond)                                                    \
+    do {                                                               \
+        if (!(cond)) {                                                 \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            s_fail = 1;                                                \
+        }                                                              \
+    } while (0)
+
+static uint32_t s_rng = 0x9E3779B9u;
+
+static uint32_t rnd(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+/* ============================
+   Simulated core and SysTick
+   ============================ */
+
+uint32_t sim_primask;
+uint32_t sim_ipsr;
+
+static volatile uint32_t s_csr;
+static volatile uint32_t s_rvr;
+static volatile uint32_t s_cvr;
+static volatile uint32_t s_icsr;        /* what an ICSR access sees / wrote */
+static uint32_t          s_icsr_shown;
+static int               s_st_pend;
+
+static uint64_t s_now;                  /* counts since reset */
+static uint64_t s_cnt;                  /* counts with SysTick enabled */
+static uint32_t s_last_addr;
+static uint32_t s_stride;
+
+static uint64_t s_ext_at = UINT64_MAX;
+static void   (*s_ext_fn)(void);
+static int      s_ext_pend;
+
+static int      s_event;
+static uint64_t s_taken;                /* exceptions entered */
+static uint64_t s_ticks;                /* SysTick exceptions entered */
+
+static void sim_count(uint64_t n);
+
+/* An ICSR write is a command: apply it before the next access */
+static void sim_icsr_commit(void)
+{
+    if (s_icsr != s_icsr_shown) {
+        if (s_icsr & SCB_ICSR_PENDSTCLR) {
+            s_st_pend = 0;
+        }
+        if (s_icsr & SCB_ICSR_PENDSTSET) {
+            s_st_pend = 1;
+        }
+    }
+    s_icsr_shown = s_st_pend ? SCB_ICSR_PENDSTSET : 0u;
+    s_icsr       = s_icsr_shown;
+}
+
+/* Take whatever is pending, unless masked or already in a handler */
+static void sim_take(void)
+{
+    while ((sim_primask == 0u) && (sim_ipsr == 0u) && (s_st_pend || s_ext_pend)) {
+        s_event = 1;
+        s_taken++;
+        if (s_st_pend) {
+            s_st_pend = 0;
+            sim_ipsr  = 15u;
+            s_ticks++;
+            sim_count(EXC_ENTRY_COUNTS);
+            SysTick_Handler();
+        } else {
+            s_ext_pend = 0;
+            sim_ipsr   = 16u;
+            sim_count(EXC_ENTRY_COUNTS);
+            s_ext_fn();
+        }
+        sim_ipsr = 0u;
+    }
+}
+
+static void sim_count(uint64_t n)
+{
+    sim_icsr_commit();
+    while (n > 0u) {
+        uint64_t d  = n;
+        int      on = (s_csr & SYST_CSR_ENABLE) != 0u;
+
+        if (on) {
+            d = (s_cvr == 0u) ? 1u : ((d < s_cvr) ? d : s_cvr);
+        }
+        if ((s_ext_at != UINT64_MAX) && (d > s_ext_at - s_now)) {
+            d = s_ext_at - s_now;
+        }
+
+        s_now += d;
+        n     -= d;
+        if (on) {
+            s_cnt += d;
+            if (s_cvr == 0u) {
+                s_cvr = s_rvr;
+            } else {
+                s_cvr -= (uint32_t)d;
+                if ((s_cvr == 0u) && (s_csr & SYST_CSR_TICKINT)) {
+                    s_st_pend = 1;
+                }
+            }
+        }
+        if (s_now == s_ext_at) {
+            s_ext_at   = UINT64_MAX;
+            s_ext_pend = 1;
+        }
+        sim_icsr_commit();
+        sim_take();
+    }
+}
+
+volatile uint32_t *sim_reg(uint32_t addr)
+{
+    sim_icsr_commit();
+    if (s_stride != 0u) {
+        sim_count(s_stride);
+    } else if ((addr == s_last_addr) && ((addr == ADDR_CVR) || (addr == ADDR_ICSR))) {
+        sim_count(1u);
+    }
+    s_last_addr = addr;
+
+    switch (addr) {
+    case ADDR_CSR:  return &s_csr;
+    case ADDR_RVR:  return &s_rvr;
+    case ADDR_CVR:  return &s_cvr;
+    case ADDR_ICSR: return &s_icsr;
+    default:
+        printf("FAIL: access to unmodelled register 0x%08x\n", (unsigned)addr);
+        exit(1);
+    }
+}
+
+uint32_t sim_cyccnt(void)
+{
+    return (uint32_t)s_now;
+}
+
+void sim_unmasked(void)
+{
+    sim_take();
+}
+
+/* Run until something is pending (WFI), or until an exception was taken
+ * if IRQs are enabled
+ */
+static void sim_sleep(void)
+{
+    uint64_t taken = s_taken;
+
+    while (!s_st_pend && !s_ext_pend && (s_taken == taken)) {
+        uint64_t n = UINT64_MAX;
+
+        if (s_csr & SYST_CSR_ENABLE) {
+            n = (s_cvr == 0u) ? 1u : s_cvr;
+        }
+        if (s_ext_at != UINT64_MAX) {
+            n = (n < s_ext_at - s_now) ? n : (s_ext_at - s_now);
+        }
+        if (n == UINT64_MAX) {
+            printf("FAIL: sleeping with nothing to wake the core\n");
+            exit(1);
+        }
+        sim_count(n);
+    }
+}
+
+void sim_wfi(void)
+{
+    sim_sleep();
+}
+
+void sim_wfe(void)
+{
+    if (!s_event) {
+        sim_sleep();
+    }
+    s_event = 0;
+}
+
+void sim_sev(void)
+{
+    s_event = 1;
+}
+
+static void sim_irq_at(uint64_t at, void (*fn)(void))
+{
+    s_ext_fn = fn;
+    if (at <= s_now) {
+        s_ext_pend = 1;
+    } else {
+        s_ext_at = at;
+    }
+}
+
+/* ============================
+   Timebase checks
+   ============================ */
+
+static uint32_t s_tpm;              /* counts per ms */
+static uint64_t s_last_us;          /* thread's last read */
+
+/* One runtime_micros64() read: it must fall inside the counts the call
+ * took (SysTick enters its first period one count after enable) and not
+ * go back past *last.
+ */
+static void check_read(uint64_t *last)
+{
+    uint64_t c0 = s_cnt;
+    uint64_t us = runtime_micros64();
+    uint64_t c1 = s_cnt;
+    uint64_t lo = ((c0 - 1u) * 1000u) / s_tpm;
+    uint64_t hi = ((c1 - 1u) * 1000u) / s_tpm;
+
+    if ((us < lo) || (us > hi) || (us < *last)) {
+        if (!s_fail) {
+            printf("FAIL %u MHz: read %llu us, counts give %llu..%llu, previous %llu\n",
+                   (unsigned)(s_tpm / 1000u), (unsigned long long)us,
+                   (unsigned long long)lo, (unsigned long long)hi,
+                   (unsigned long long)*last);
+        }
+        s_fail = 1;
+    }
+    *last = us;
+}
+
+static void sim_reset(uint32_t sysclk_hz)
+{
+    s_csr = s_rvr = s_cvr = 0;
+    s_icsr = s_icsr_shown = 0;
+    s_st_pend  = 0;
+    s_ext_at   = UINT64_MAX;
+    s_ext_pend = 0;
+    s_stride   = 0;
+    s_cnt      = 0;
+    s_ticks    = 0;
+    s_last_us  = 0;
+    sim_primask = 0;
+
+    g_systick_ms = 0;
+    s_tpm = sysclk_hz / 1000u;
+    runtime_init(sysclk_hz);
+    sim_count(1u);
+}
+
+/* ============================
+   Scenarios
+   ============================ */
+
+static void run_delays(void)
+{
+    static const uint32_t delay[] = { 1, 2, 3, 5, 17, 100, 209, 210, 1000, 4195, 20000 };
+    uint32_t max_ms = (SYST_RVR_MAX + 1u) / s_tpm;
+
+    for (uint32_t i = 0; i < sizeof(delay) / sizeof(delay[0]); i++) {
+        uint32_t d     = delay[i];
+        uint32_t start = runtime_millis();
+        uint64_t ticks = s_ticks;
+
+        runtime_delay_ms(d);
+        CHECK(runtime_millis() - start == d);
+        CHECK(s_ticks - ticks <= 2u * (1u + d / max_ms));
+        check_read(&s_last_us);
+    }
+}
+
+/* ISR: step count by count through the next wrap, reading each time */
+static void probe_wrap(void)
+{
+    check_read(&s_last_us);
+
+    /* Never past a second wrap while the first is still pending: no
+     * timebase survives an ISR that holds SysTick off for a whole period
+     */
+    if ((s_cvr > 3u) && !s_st_pend) {
+        sim_count(s_cvr - 3u);
+    }
+    for (uint32_t i = 0; i < 8u; i++) {
+        check_read(&s_last_us);
+        sim_count(1u);
+    }
+}
+
+static void nop_isr(void)
+{
+}
+
+static runtime_timer_t s_pacer;
+
+static void pacer_fn(runtime_timer_t *timer, void *arg)
+{
+    (void)timer;
+    (void)arg;
+}
+
+/* Wraps into and out of stretches of many lengths: a periodic timer sets
+ * the stretch, the probe lands anywhere in it.
+ */
+static void run_wraps(uint32_t rounds)
+{
+    uint32_t max_ms = (SYST_RVR_MAX + 1u) / s_tpm;
+
+    runtime_timer_init(&s_pacer, pacer_fn, 0);
+    for (uint32_t r = 0; r < rounds; r++) {
+        if ((r % 16u) == 0u) {
+            uint32_t p = 2u + rnd() % (max_ms + 8u);
+            runtime_timer_start(&s_pacer, p, p);
+        }
+
+        sim_irq_at(s_now + rnd() % (2u * s_tpm * max_ms), probe_wrap);
+        while (s_ext_pend || (s_ext_at != UINT64_MAX)) {
+            runtime_idle();
+        }
+        check_read(&s_last_us);
+    }
+    runtime_timer_cancel(&s_pacer);
+}
+
+/* Thread reads with SysTick_Handler preempting between register reads:
+ * across the end of a stretched period (the idle was cut short by an
+ * ISR), then across the 1 ms wrap after it. The idle itself is entered
+ * just before a wrap, with counts passing between its register reads.
+ */
+static void run_preempt(uint32_t rounds)
+{
+    for (uint32_t r = 0; r < rounds; r++) {
+        uint32_t lead = rnd() % 96u;
+
+        if (s_cvr > lead) {
+            sim_count(s_cvr - lead);
+        }
+        sim_irq_at(s_now + rnd() % (8u * s_tpm), nop_isr);
+        s_stride = 1u + rnd() % 3u;
+        while (s_ext_pend || (s_ext_at != UINT64_MAX)) {
+            runtime_idle();
+        }
+        s_stride = 0;
+
+        for (uint32_t w = 0; w < 2u; w++) {
+            uint32_t lead  = 16u + rnd() % 256u;
+            uint64_t ticks = s_ticks;
+
+            if (s_cvr > lead) {
+                sim_count(s_cvr - lead);
+            }
+            s_stride = 1u + rnd() % 7u;
+            while (s_ticks == ticks) {
+                check_read(&s_last_us);
+            }
+            for (uint32_t i = 0; i < 8u; i++) {
+                check_read(&s_last_us);
+            }
+            s_stride = 0;
+        }
+    }
+}
+
+#define TIMERS  (8u)
+
+typedef struct {
+    runtime_timer_t timer;
+    uint64_t        armed_at;       /* counts */
+    uint32_t        fired;
+} sim_timer_t;
+
+static sim_timer_t s_timer[TIMERS];
+static uint32_t    s_late_max;
+static uint32_t    s_late_near;     /* 1 ms late, armed within DEADLINE_SLACK */
+static uint32_t    s_fired;
+static uint32_t    s_max_delay;     /* for the next arm */
+
+static void arm(sim_timer_t *st)
+{
+    st->armed_at = s_cnt - 1u;
+    st->fired    = 0;
+    runtime_timer_start(&st->timer, 1u + rnd() % s_max_delay, 0u);
+}
+
+static void timer_fn(runtime_timer_t *timer, void *arg)
+{
+    sim_timer_t *st   = (sim_timer_t *)arg;
+    uint32_t     now  = (uint32_t)((s_cnt - 1u) / s_tpm);
+    int32_t      late = (int32_t)(now - timer->expires);
+    uint64_t     due  = (uint64_t)timer->expires * s_tpm;
+
+    CHECK(late >= 0);
+    if (late > 0) {
+        if ((late == 1) && (due - st->armed_at < DEADLINE_SLACK)) {
+            s_late_near++;
+        } else if ((uint32_t)late > s_late_max) {
+            s_late_max = (uint32_t)late;
+        }
+    }
+    st->fired = 1;
+    s_fired++;
+
+    /* Chained: armed from the SysTick callback, maybe into a stretch */
+    if ((rnd() & 1u) != 0u) {
+        arm(st);
+    }
+}
+
+static void arm_isr(void)
+{
+    sim_timer_t *st = &s_timer[rnd() % TIMERS];
+
+    if (!runtime_timer_active(&st->timer)) {
+        arm(st);
+    }
+}
+
+/* One-shots armed from an ISR while the thread idles. The ISR lands:
+ *   0: anywhere in the stretch
+ *   1: in the 1 ms period before it, with the stretch only queued
+ *   2: right at the end of the running period, so the wrap can be
+ *      pending by the time the timer is armed
+ *   3: just before a millisecond boundary, for a 1-2 ms deadline
+ */
+static void run_timers(uint32_t rounds)
+{
+    uint32_t max_ms = (SYST_RVR_MAX + 1u) / s_tpm;
+
+    for (uint32_t i = 0; i < TIMERS; i++) {
+        runtime_timer_init(&s_timer[i].timer, timer_fn, &s_timer[i]);
+    }
+    for (uint32_t r = 0; r < rounds; r++) {
+        uint64_t at;
+
+        s_max_delay = 2u * max_ms;
+        switch (r % 4u) {
+        case 0:
+            at = s_now + rnd() % (s_tpm * max_ms);
+            break;
+        case 1:
+            at = s_now + rnd() % s_tpm;
+            break;
+        case 2:
+            at = s_now + s_cvr + 16u - rnd() % 128u;
+            break;
+        default: {
+            uint64_t ms = (s_cnt - 1u) / s_tpm + 1u + rnd() % max_ms;
+            at = s_now + (ms * s_tpm - (s_cnt - 1u)) - EXC_ENTRY_COUNTS - rnd() % 96u;
+            s_max_delay = 2u;
+            break;
+        }
+        }
+
+        sim_irq_at(at, arm_isr);
+        while (s_ext_pend || (s_ext_at != UINT64_MAX)) {
+            runtime_idle();
+        }
+    }
+
+    /* Let everything run out */
+    for (uint32_t i = 0; i < TIMERS; i++) {
+        while (runtime_timer_active(&s_timer[i].timer)) {
+            runtime_idle();
+        }
+    }
+    check_read(&s_last_us);
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t sysclk[] = { 1000000u, 4000000u, 16000000u, 80000000u };
+    uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 5000u;
+
+    for (uint32_t i = 0; i < sizeof(sysclk) / sizeof(sysclk[0]); i++) {
+        sim_reset(sysclk[i]);
+
+        s_late_max = s_late_near = s_fired = 0;
+        run_delays();
+        run_wraps(rounds);
+        run_preempt(rounds / 10u);
+        run_timers(rounds);
+        CHECK(s_late_max == 0u);
+
+        printf("%2u MHz: %.1f s simulated, %llu SysTick wrap(s), %u timers fired "
+               "(%u armed within %u counts of the deadline, 1 ms late), max late %u ms\n",
+               (unsigned)(sysclk[i] / 1000000u), (double)s_cnt / (double)sysclk[i],
+               (unsigned long long)s_ticks, (unsigned)s_fired, (unsigned)s_late_near,
+               (unsigned)DEADLINE_SLACK, (unsigned)s_late_max);
+        if (s_fail) {
+            break;
+        }
+    }
+    return s_fail;
+}
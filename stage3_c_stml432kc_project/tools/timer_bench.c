@@ -0,0 +1,405 @@
+/* timer_bench.c — host checks and timing for runtime_timer.c
+ *                 (make timer-bench)
+ *
+ * The wheel runs against a fake millisecond clock, driven the way
+ * SysTick_Handler drives it, over one fixed schedule of arms, re-arms and
+ * cancels:
+ *
+ *   tick     : runtime_timer_advance() every millisecond
+ *   stretch  : one advance per stretched SysTick period, as the tickless
+ *              runtime does it: up to runtime_timer_next_due() or the
+ *              longest reload (209 ms at 80 MHz, 4194 ms at 4 MHz), and
+ *              cut short through runtime_tick_deadline() when a timer is
+ *              armed inside the stretch
+ *
+ * Thousands of one-shot, periodic and self-re-arming timers, with
+ * deadlines from 1 ms to well past the ~17 min the wheel spans. Every
+ * expiry must land on its deadline (not late, not early), expiries come
+ * in deadline order, and the stretched runs must expire exactly the same
+ * timers at the same milliseconds as the ticked one.
+ *
+ * Then ns per start + cancel, per expiry, and per simulated millisecond
+ * in each mode.
+ *
+ *   $ make timer-bench
+ */
+
+/* _POSIX_C_SOURCE (clock_gettime) is set by the Makefile: the
+ * force-included shim has already pulled in <stdint.h> by this line.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime.h"
+#include "runtime_timer.h"
+
+#define TIMERS     (4096u)
+#define EVENTS     (40000u)          /* re-arms and cancels */
+#define HORIZON    (2500000u)        /* ms, ~42 min */
+#define LOG_MAX    (4000000u)
+
+static int s_fail;
+
+#define CHECK(cond)                                                    \
+    do {                                                               \
+        if (!(cond)) {                                                 \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            s_fail = 1;                                                \
+        }                                                              \
+    } while (0)
+
+static uint32_t s_rng;
+
+static uint32_t rnd(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+/* Same value in every run for the same (timer, firing) */
+static uint32_t mix(uint32_t a, uint32_t b)
+{
+    uint32_t h = (a * 0x9E3779B1u) ^ (b * 0x85EBCA77u);
+
+    h ^= h >> 15;
+    h *= 0xC2B2AE3Du;
+    h ^= h >> 13;
+    return h;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ============================
+   What runtime.c provides
+   ============================ */
+
+uint32_t sim_primask;
+
+void sim_unmasked(void)
+{
+}
+
+static uint32_t s_now;           /* the fake runtime_millis() */
+static uint32_t s_stretch_end;   /* tick the running stretch ends on */
+static int      s_stretching;
+static uint32_t s_cuts;
+
+uint32_t runtime_millis(void)
+{
+    return s_now;
+}
+
+/* As in runtime.c: a deadline inside the running stretch cuts it short */
+void runtime_tick_deadline(uint32_t due_ms)
+{
+    if (s_stretching && ((int32_t)(due_ms - s_stretch_end) < 0)) {
+        s_stretch_end = due_ms;
+        s_cuts++;
+    }
+}
+
+/* ============================
+   Schedule and expiry log
+   ============================ */
+
+typedef struct {
+    uint32_t ms;
+    uint32_t timer;
+    uint32_t delay;      /* 0 = cancel */
+    uint32_t period;
+    uint32_t order;      /* ties on ms keep schedule order */
+} event_t;
+
+typedef struct {
+    uint32_t ms;
+    uint32_t timer;
+} fire_t;
+
+typedef struct {
+    runtime_timer_t timer;
+    uint32_t        id;
+    uint32_t        due;       /* expected next expiry */
+    uint32_t        fires;
+    uint32_t        chain;     /* one-shot that re-arms itself */
+} bench_timer_t;
+
+static bench_timer_t s_timer[TIMERS];
+static event_t       s_event[TIMERS + EVENTS];
+static uint32_t      s_events;
+
+static fire_t  *s_log;
+static uint32_t s_logged;
+static uint32_t s_late;
+static uint32_t s_early;
+
+static uint32_t pick_delay(void)
+{
+    uint32_t r = rnd() % 100u;
+
+    if (r < 60u) {
+        return 1u + rnd() % 1000u;
+    }
+    if (r < 90u) {
+        return 1u + rnd() % 100000u;
+    }
+    return 1u + rnd() % 2000000u;     /* past the wheel span */
+}
+
+static int event_cmp(const void *a, const void *b)
+{
+    const event_t *x = a;
+    const event_t *y = b;
+
+    if (x->ms != y->ms) {
+        return (x->ms > y->ms) - (x->ms < y->ms);
+    }
+    return (x->order > y->order) - (x->order < y->order);
+}
+
+static void build_schedule(void)
+{
+    s_rng = 0x2545F491u;
+    s_events = 0;
+
+    for (uint32_t i = 0; i < TIMERS; i++) {
+        event_t *e = &s_event[s_events++];
+
+        e->ms     = rnd() % (HORIZON / 4u);
+        e->timer  = i;
+        e->delay  = pick_delay();
+        e->period = ((rnd() % 4u) == 0u) ? 100u + rnd() % 60000u : 0u;
+        s_timer[i].chain = (e->period == 0u) && ((rnd() % 4u) == 0u);
+    }
+    for (uint32_t i = 0; i < EVENTS; i++) {
+        event_t *e = &s_event[s_events++];
+
+        e->ms     = rnd() % HORIZON;
+        e->timer  = rnd() % TIMERS;
+        e->delay  = ((rnd() % 4u) == 0u) ? 0u : pick_delay();
+        e->period = ((e->delay != 0u) && ((rnd() % 8u) == 0u)) ? 100u + rnd() % 60000u : 0u;
+    }
+
+    for (uint32_t i = 0; i < s_events; i++) {
+        s_event[i].order = i;
+    }
+    qsort(s_event, s_events, sizeof(event_t), event_cmp);
+}
+
+static void on_expire(runtime_timer_t *timer, void *arg)
+{
+    bench_timer_t *bt = arg;
+
+    if (s_now != bt->due) {
+        if ((int32_t)(s_now - bt->due) > 0) {
+            s_late++;
+        } else {
+            s_early++;
+        }
+    }
+    if (s_logged > 0u) {
+        CHECK(s_log[s_logged - 1u].ms <= s_now);
+    }
+    if (s_logged < LOG_MAX) {
+        s_log[s_logged].ms    = s_now;
+        s_log[s_logged].timer = bt->id;
+        s_logged++;
+    }
+
+    bt->fires++;
+    if (timer->period != 0u) {
+        bt->due += timer->period;
+    } else if (bt->chain) {
+        uint32_t delay = 1u + mix(bt->id, bt->fires) % 3000u;
+
+        bt->due = s_now + delay;
+        runtime_timer_start(timer, delay, 0u);
+    }
+}
+
+static void apply(const event_t *e)
+{
+    bench_timer_t *bt = &s_timer[e->timer];
+
+    if (e->delay == 0u) {
+        runtime_timer_cancel(&bt->timer);
+    } else {
+        bt->due = s_now + e->delay;
+        runtime_timer_start(&bt->timer, e->delay, e->period);
+    }
+}
+
+static void reset_timers(void)
+{
+    for (uint32_t i = 0; i < TIMERS; i++) {
+        runtime_timer_cancel(&s_timer[i].timer);
+        runtime_timer_init(&s_timer[i].timer, on_expire, &s_timer[i]);
+        s_timer[i].id    = i;
+        s_timer[i].fires = 0;
+    }
+    s_logged = 0;
+    s_late   = 0;
+    s_early  = 0;
+    s_now    = 0;
+}
+
+/* ============================
+   Runs
+   ============================ */
+
+static double run_tick(void)
+{
+    uint32_t ev = 0;
+    double   t0;
+
+    reset_timers();
+    t0 = now_ns();
+    while ((ev < s_events) && (s_event[ev].ms == 0u)) {
+        apply(&s_event[ev++]);
+    }
+    for (s_now = 1; s_now <= HORIZON; s_now++) {
+        runtime_timer_advance(s_now);
+        while ((ev < s_events) && (s_event[ev].ms == s_now)) {
+            apply(&s_event[ev++]);
+        }
+    }
+    return now_ns() - t0;
+}
+
+static double run_stretch(uint32_t max_ms, uint32_t *wakeups)
+{
+    uint32_t ev = 0;
+    uint32_t due;
+    double   t0;
+
+    reset_timers();
+    *wakeups = 0;
+    s_cuts   = 0;
+    t0 = now_ns();
+    while ((ev < s_events) && (s_event[ev].ms == 0u)) {
+        apply(&s_event[ev++]);
+    }
+
+    uint32_t now = 0;
+    while (now < HORIZON) {
+        s_stretch_end = now + max_ms;
+        if (runtime_timer_next_due(&due) && ((int32_t)(due - s_stretch_end) < 0)) {
+            s_stretch_end = due;
+        }
+        if ((int32_t)(s_stretch_end - HORIZON) > 0) {
+            s_stretch_end = HORIZON;
+        }
+
+        /* Arms and cancels that land inside the stretch */
+        s_stretching = 1;
+        while ((ev < s_events) && ((int32_t)(s_event[ev].ms - s_stretch_end) < 0)) {
+            s_now = s_event[ev].ms;
+            apply(&s_event[ev++]);
+        }
+        s_stretching = 0;
+
+        now = s_now = s_stretch_end;
+        runtime_timer_advance(now);
+        (*wakeups)++;
+        while ((ev < s_events) && (s_event[ev].ms == now)) {
+            apply(&s_event[ev++]);
+        }
+    }
+    return now_ns() - t0;
+}
+
+static int fire_cmp(const void *a, const void *b)
+{
+    const fire_t *x = a;
+    const fire_t *y = b;
+
+    if (x->ms != y->ms) {
+        return (x->ms > y->ms) - (x->ms < y->ms);
+    }
+    return (x->timer > y->timer) - (x->timer < y->timer);
+}
+
+static double bench_start_cancel(void)
+{
+    const uint32_t rounds = 2000000u;
+    double         t0;
+
+    reset_timers();
+    s_rng = 0x1234567u;
+    for (uint32_t i = 0; i < TIMERS; i++) {
+        runtime_timer_start(&s_timer[i].timer, pick_delay(), 0u);
+    }
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < rounds; i++) {
+        runtime_timer_t *t = &s_timer[i % TIMERS].timer;
+
+        runtime_timer_cancel(t);
+        runtime_timer_start(t, 1u + (i * 2654435761u) % 200000u, 0u);
+    }
+    return (now_ns() - t0) / rounds;
+}
+
+int main(void)
+{
+    static const uint32_t stretch_ms[] = { 209u, 4194u };
+    uint32_t  fired;
+    uint32_t  wakeups;
+    int       same;
+    double    ns;
+    fire_t   *ref;
+
+    s_log = malloc(sizeof(fire_t) * LOG_MAX);
+    ref   = malloc(sizeof(fire_t) * LOG_MAX);
+    if ((s_log == NULL) || (ref == NULL)) {
+        return 1;
+    }
+    build_schedule();
+
+    ns = run_tick();
+    fired = s_logged;
+    CHECK((s_late == 0u) && (s_early == 0u));
+    CHECK(fired < LOG_MAX);
+    printf("tick       : %u timers, %u expiries over %u ms, late %u, early %u\n",
+           (unsigned)TIMERS, (unsigned)fired, (unsigned)HORIZON,
+           (unsigned)s_late, (unsigned)s_early);
+    printf("             %.1f ns per ms, %.1f ns per expiry\n",
+           ns / HORIZON, ns / fired);
+
+    memcpy(ref, s_log, sizeof(fire_t) * fired);
+    qsort(ref, fired, sizeof(fire_t), fire_cmp);
+
+    for (uint32_t i = 0; i < sizeof(stretch_ms) / sizeof(stretch_ms[0]); i++) {
+        ns = run_stretch(stretch_ms[i], &wakeups);
+        CHECK((s_late == 0u) && (s_early == 0u));
+
+        qsort(s_log, s_logged, sizeof(fire_t), fire_cmp);
+        same = (s_logged == fired) && (memcmp(s_log, ref, sizeof(fire_t) * fired) == 0);
+        CHECK(same);
+
+        printf("stretch %4u: %u expiries on %u wake-ups (%u cut short), late %u, early %u, %s the ticked run\n",
+               (unsigned)stretch_ms[i], (unsigned)s_logged, (unsigned)wakeups,
+               (unsigned)s_cuts, (unsigned)s_late, (unsigned)s_early,
+               same ? "same as" : "DIFFERENT from");
+        printf("             %.1f ns per ms, %.1f ns per wake-up\n",
+               ns / HORIZON, ns / wakeups);
+    }
+
+    printf("start+cancel: %.1f ns per pair, %u timers armed\n",
+           bench_start_cancel(), (unsigned)TIMERS);
+
+    free(ref);
+    free(s_log);
+    return s_fail;
+}
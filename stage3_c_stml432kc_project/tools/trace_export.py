@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""trace_export.py — g_trace (runtime_trace.h) to Chrome / Perfetto JSON
+
+Reads the event ring out of a RAM dump, names events and interrupt
+tracks from the ELF, and writes the Chrome trace-event format that
+ui.perfetto.dev and chrome://tracing open directly:
+
+    (gdb) dump binary memory ram.bin 0x20000000 0x2000C000
+    python3 tools/trace_export.py build/blink.elf --dump ram.bin -o trace.json
+
+One track per context: thread mode, SysTick, PendSV, and each IRQ (named
+after its handler in the flash vector table when the ELF has one).
+CYCCNT is unwrapped across its 32-bit overflow and converted to time at
+the clock recorded by RUNTIME_TRACE_CLOCK events.
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from elf32 import Elf32, MemoryImage, parse_dump_arg  # noqa: E402
+
+HEADER = "<II"           # head, hz
+EVENT = "<IIHH"          # cycles, name or value (CLOCK: Hz), ctx, type
+EVENT_SIZE = struct.calcsize(EVENT)
+
+RESET_HZ = 4000000       # MSI after reset, until the first clock event
+
+SYSTEM_CONTEXTS = {
+    0: "thread",
+    2: "NMI",
+    3: "HardFault",
+    11: "SVCall",
+    14: "PendSV",
+    15: "SysTick",
+}
+
+
+def read_events(elf, mem):
+    sym = elf.symbol("g_trace")
+    if sym is None:
+        raise ValueError("g_trace not in the ELF: build with make TRACE=1")
+    capacity = (sym.size - struct.calcsize(HEADER)) // EVENT_SIZE
+    head, hz = struct.unpack(HEADER, mem.read(sym.value, struct.calcsize(HEADER)))
+    base = sym.value + struct.calcsize(HEADER)
+
+    count = min(head, capacity)
+    events = []
+    for seq in range(head - count, head):
+        slot = seq % capacity
+        events.append(struct.unpack(EVENT, mem.read(base + slot * EVENT_SIZE, EVENT_SIZE)))
+    return events, head, capacity, hz
+
+
+def context_name(elf, ctx):
+    if ctx in SYSTEM_CONTEXTS:
+        return SYSTEM_CONTEXTS[ctx]
+    if ctx >= 16:
+        vec = elf.section(".isr_vector")
+        raw = elf.read(vec.addr + ctx * 4, 4) if vec is not None else None
+        if raw is not None:
+            target = struct.unpack("<I", raw)[0] & ~1
+            for fn in elf.functions():
+                if fn.value == target and fn.name != "Default_Handler":
+                    return "IRQ%d %s" % (ctx - 16, fn.name)
+        return "IRQ%d" % (ctx - 16)
+    return "exception %d" % ctx
+
+
+def convert(elf, events, start_hz):
+    out = []
+    depth = {}
+    hz = start_hz
+    t_us = 0.0
+    prev = None
+
+    for cycles, arg, ctx, etype in events:
+        if prev is not None:
+            delta = (cycles - prev) & 0xFFFFFFFF
+            if delta & 0x80000000:
+                delta -= 1 << 32   # an ISR stamped in between claim and stamp
+            t_us += delta * 1e6 / hz
+        prev = cycles
+
+        ph = chr(etype) if 0 < etype < 128 else "?"
+        if ph == "C":
+            hz = arg
+            out.append({"name": "sysclk", "ph": "C", "ts": t_us, "pid": 1,
+                        "args": {"MHz": hz / 1e6}})
+            continue
+        if ph not in "BEi":
+            continue
+
+        label = elf.read_cstr(arg, 64) or "0x%08x" % arg
+        ev = {"name": label, "ph": ph, "ts": t_us, "pid": 1, "tid": ctx}
+        if ph == "B":
+            depth[ctx] = depth.get(ctx, 0) + 1
+        elif ph == "E":
+            if depth.get(ctx, 0) == 0:
+                continue           # its begin was overwritten in the ring
+            depth[ctx] -= 1
+        else:
+            ev["s"] = "t"
+        out.append(ev)
+
+    meta = [{"name": "process_name", "ph": "M", "pid": 1,
+             "args": {"name": os.path.basename(elf.path)}}]
+    for ctx in sorted({e[2] for e in events}):
+        meta.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": ctx,
+                     "args": {"name": context_name(elf, ctx)}})
+        meta.append({"name": "thread_sort_index", "ph": "M", "pid": 1, "tid": ctx,
+                     "args": {"sort_index": ctx}})
+    return meta + out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("elf", help="firmware ELF built with make TRACE=1")
+    ap.add_argument("--dump", action="append", required=True, metavar="FILE[@ADDR]",
+                    help="RAM dump and its base address (default 0x20000000); repeatable")
+    ap.add_argument("-o", "--output", help="JSON file (default: stdout)")
+    ap.add_argument("--hz", type=int,
+                    help="clock before the first clock event "
+                         "(default: reset MSI, or g_trace.hz once the ring wrapped)")
+    args = ap.parse_args()
+
+    elf = Elf32(args.elf)
+    mem = MemoryImage()
+    for arg in args.dump:
+        path, base = parse_dump_arg(arg)
+        with open(path, "rb") as f:
+            mem.add(base, f.read())
+
+    events, head, capacity, hz = read_events(elf, mem)
+    start_hz = args.hz or (hz if head > capacity and hz else RESET_HZ)
+    trace = {"traceEvents": convert(elf, events, start_hz),
+             "displayTimeUnit": "ns",
+             "otherData": {"events_recorded": head, "events_kept": len(events)}}
+
+    text = json.dumps(trace, indent=1)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        print(text)
+    print("%d events (%d recorded, ring of %d)" % (len(events), head, capacity),
+          file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -18,6 +18,34 @@
 #define SYST_CSR_TICKINT   (1u << 1)
 #define SYST_CSR_CLKSOURCE (1u << 2)
 
+/* ============================
+   SCB (Cortex-M)
+   ============================ */
+#define SCB_ICSR           REG32(0xE000ED04u)
+#define SCB_ICSR_PENDSTSET (1u << 26)
+
+/* ============================
+   DWT cycle counter (Cortex-M)
+   ============================ */
+#define DEMCR              REG32(0xE000EDFCu)
+#define DWT_CTRL           REG32(0xE0001000u)
+#define DWT_CYCCNT         REG32(0xE0001004u)
+
+#define DEMCR_TRCENA       (1u << 24)
+#define DWT_CTRL_CYCCNTENA (1u << 0)
+
+/* Start the free-running core cycle counter (idempotent) */
+static inline void arch_cyccnt_enable(void)
+{
+    DEMCR    |= DEMCR_TRCENA;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+static inline uint32_t arch_cyccnt(void)
+{
+    return DWT_CYCCNT;
+}
+
 /* ============================
    IRQ control (Cortex-M)
    ============================ */
@@ -31,5 +59,13 @@ static inline void arch_irq_enable(void)
     __asm__ volatile ("cpsie i" ::: "memory");
 }
 
+/* ============================
+   Sleep (Cortex-M)
+   ============================ */
+static inline void arch_wfi(void)
+{
+    __asm__ volatile ("dsb\n\twfi" ::: "memory");
+}
+
 #endif /* ARCH_CORTEXM_BAREMETAL_H */
 
@@ -0,0 +1,17 @@
+/* bench.c — shared plumbing for benchmark builds (make BENCH=<name>) */
+
+#include "bench.h"
+#include "board.h"
+#include "arch_cortexm_baremetal.h"
+
+volatile uint32_t g_bench_done;
+
+void bench_finish(void)
+{
+    g_bench_done = 1u;
+    board_led_on();
+
+    for (;;) {
+        arch_wfi();
+    }
+}
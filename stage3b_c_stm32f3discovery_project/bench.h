@@ -0,0 +1,50 @@
+/* bench.h — on-target benchmark builds
+ *
+ * Built only with `make BENCH=<name>`: main() hands over to
+ * bench_<name>_run() once the runtime is up. Results are plain RAM
+ * structs (g_bench_*) read from the debugger; no UART, no printf.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+/* Cycle statistics accumulator */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;   /* mean = sum / count */
+} bench_stat_t;
+
+static inline void bench_stat_reset(bench_stat_t *s)
+{
+    s->count = 0;
+    s->min   = UINT32_MAX;
+    s->max   = 0;
+    s->sum   = 0;
+}
+
+static inline void bench_stat_add(bench_stat_t *s, uint32_t cycles)
+{
+    s->count++;
+    s->sum += cycles;
+    if (cycles < s->min) {
+        s->min = cycles;
+    }
+    if (cycles > s->max) {
+        s->max = cycles;
+    }
+}
+
+/* Set when the selected benchmark has finished */
+extern volatile uint32_t g_bench_done;
+
+/* Mark results final, LED solid on, idle forever */
+void bench_finish(void) __attribute__((noreturn));
+
+/* Benchmark entry points (one per bench_<name>.c) */
+void bench_ccm_run(void);
+
+#endif /* BENCH_H */
@@ -0,0 +1,121 @@
+/* bench_ccm.c — CCM RAM vs SRAM / flash (make BENCH=ccm)
+ *
+ * One data kernel (read-modify-write over 256 words) is built twice, in
+ * flash (.text) and in CCM (.ccm), and run over a buffer in SRAM and one
+ * in CCM: a 2 x 2 matrix of code x data placement.
+ *
+ * The tick handler is timed by pending SysTick from thread mode (entry,
+ * handler body, exit, with the stack in CCM). Its placement is fixed per
+ * build, so compare `make BENCH=ccm` with `make BENCH=ccm TICK_CCM=0`.
+ *
+ *   (gdb) p g_bench_ccm
+ *
+ * At the 8 MHz reset clock flash has no wait states; CCM wins on bus
+ * concurrency (fetch on I-bus, data on D-bus, nothing on the SRAM bus).
+ */
+
+#include "bench.h"
+#include "runtime_section.h"
+#include "arch_cortexm_baremetal.h"
+
+#define BENCH_CCM_WORDS   (256u)
+#define BENCH_CCM_ITERS   (64u)
+#define BENCH_CCM_TICKS   (256u)
+
+typedef struct {
+    bench_stat_t flash_code_sram_data;
+    bench_stat_t flash_code_ccm_data;
+    bench_stat_t ccm_code_sram_data;
+    bench_stat_t ccm_code_ccm_data;
+    bench_stat_t tick;          /* pend -> return, cycles */
+    uint32_t     tick_in_ccm;
+    uint32_t     errors;        /* placements disagree (must be 0) */
+} bench_ccm_t;
+
+bench_ccm_t g_bench_ccm;
+
+static uint32_t                  s_sram_buf[BENCH_CCM_WORDS];
+RUNTIME_CCM_BSS static uint32_t  s_ccm_buf[BENCH_CCM_WORDS];
+
+/* One body, two placements */
+#define KERNEL_BODY                                                       \
+    uint32_t acc = 0;                                                     \
+    for (uint32_t i = 0; i < BENCH_CCM_WORDS; i++) {                      \
+        uint32_t v = buf[i];                                              \
+        acc += v;                                                         \
+        buf[i] = (v << 1) ^ (acc >> 3) ^ seed;                            \
+    }                                                                     \
+    return acc
+
+static __attribute__((noinline)) uint32_t kernel_flash(uint32_t *buf, uint32_t seed)
+{
+    KERNEL_BODY;
+}
+
+RUNTIME_CCM_FUNC static uint32_t kernel_ccm(uint32_t *buf, uint32_t seed)
+{
+    KERNEL_BODY;
+}
+
+static void fill(uint32_t *buf)
+{
+    for (uint32_t i = 0; i < BENCH_CCM_WORDS; i++) {
+        buf[i] = i * 2654435761u;
+    }
+}
+
+typedef uint32_t (*kernel_fn)(uint32_t *buf, uint32_t seed);
+
+/* Results of the first placement; every other one must reproduce them */
+static uint32_t s_ref[BENCH_CCM_ITERS];
+
+/* Same inputs through each placement */
+static void measure(bench_stat_t *stat, kernel_fn fn, uint32_t *buf, uint32_t first)
+{
+    fill(buf);
+
+    for (uint32_t n = 0; n < BENCH_CCM_ITERS; n++) {
+        arch_irq_disable();
+        uint32_t t0  = arch_cyccnt();
+        uint32_t acc = fn(buf, n);
+        uint32_t t1  = arch_cyccnt();
+        arch_irq_enable();
+
+        bench_stat_add(stat, t1 - t0);
+        if (first) {
+            s_ref[n] = acc;
+        } else if (s_ref[n] != acc) {
+            g_bench_ccm.errors++;
+        }
+    }
+}
+
+void bench_ccm_run(void)
+{
+    arch_cyccnt_enable();
+
+    bench_stat_reset(&g_bench_ccm.flash_code_sram_data);
+    bench_stat_reset(&g_bench_ccm.flash_code_ccm_data);
+    bench_stat_reset(&g_bench_ccm.ccm_code_sram_data);
+    bench_stat_reset(&g_bench_ccm.ccm_code_ccm_data);
+    bench_stat_reset(&g_bench_ccm.tick);
+
+    measure(&g_bench_ccm.flash_code_sram_data, kernel_flash, s_sram_buf, 1u);
+    measure(&g_bench_ccm.flash_code_ccm_data,  kernel_flash, s_ccm_buf,  0u);
+    measure(&g_bench_ccm.ccm_code_sram_data,   kernel_ccm,   s_sram_buf, 0u);
+    measure(&g_bench_ccm.ccm_code_ccm_data,    kernel_ccm,   s_ccm_buf,  0u);
+
+    /* Each forced tick credits 1 ms; millis runs ahead in this build */
+    for (uint32_t n = 0; n < BENCH_CCM_TICKS; n++) {
+        uint32_t t0 = arch_cyccnt();
+        SCB_ICSR = SCB_ICSR_PENDSTSET;
+        __asm__ volatile ("dsb\n isb" ::: "memory");
+        bench_stat_add(&g_bench_ccm.tick, arch_cyccnt() - t0);
+    }
+
+#ifdef RUNTIME_TICK_CCM
+    g_bench_ccm.tick_in_ccm = 1u;
+#endif
+
+    bench_finish();
+}
@@ -4,6 +4,9 @@
 #include <stdint.h>
 #include "runtime.h"
 #include "board.h"
+#ifdef BENCH
+#include "bench.h"
+#endif
 
 int main(void)
 {
@@ -17,6 +20,11 @@ int main(void)
     runtime_init(SYSCLK_HZ);
     runtime_irq_enable();
 
+#ifdef BENCH
+    /* Benchmark build: hand over; results land in g_bench_* (see README) */
+    BENCH_ENTRY();
+#endif
+
     /* guard window: prove SysTick and IRQs are alive */
     board_led_on();
     runtime_delay_ms(150u);
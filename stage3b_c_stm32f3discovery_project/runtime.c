@@ -1,6 +1,7 @@
 /* runtime.c — minimal explicit runtime services */
 
 #include "runtime.h"
+#include "runtime_section.h"
 #include "arch_cortexm_baremetal.h"
 
 /* SysTick registers */
@@ -14,11 +15,18 @@
 /* Global tick counter (incremented in SysTick_Handler) */
 volatile uint32_t g_systick_ms = 0;
 
+/* Tick handler runs from CCM unless built with TICK_CCM=0 */
+#ifdef RUNTIME_TICK_CCM
+#define TICK_PLACEMENT RUNTIME_CCM_FUNC
+#else
+#define TICK_PLACEMENT
+#endif
+
 /* SysTick interrupt handler
  * Owns system millisecond timebase.
  * Must be linked into vector table.
  */
-void SysTick_Handler(void)
+TICK_PLACEMENT void SysTick_Handler(void)
 {
     g_systick_ms++;
 }
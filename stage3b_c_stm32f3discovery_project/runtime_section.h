@@ -0,0 +1,22 @@
+/* runtime_section.h — CCM RAM placement attributes
+ *
+ * The F303's 8 KiB core-coupled memory (0x10000000) sits on the core's
+ * I-bus and D-bus with zero wait states; no DMA master can reach it.
+ * linker.ld collects these sections into .ccm / .ccm_bss, and startup.s
+ * copies / zeroes them before main(). The main stack lives there too.
+ *
+ *   RUNTIME_CCM_FUNC void SysTick_Handler(void) { ... }
+ *   RUNTIME_CCM_DATA static uint32_t s_coeffs[4] = { 1, 2, 3, 4 };
+ *   RUNTIME_CCM_BSS  static uint32_t s_work[256];
+ *
+ * Calls between flash and CCM go through linker long-branch veneers.
+ */
+
+#ifndef RUNTIME_SECTION_H
+#define RUNTIME_SECTION_H
+
+#define RUNTIME_CCM_FUNC  __attribute__((section(".ccm.text"), noinline))
+#define RUNTIME_CCM_DATA  __attribute__((section(".ccm.data")))
+#define RUNTIME_CCM_BSS   __attribute__((section(".ccm.bss")))
+
+#endif /* RUNTIME_SECTION_H */
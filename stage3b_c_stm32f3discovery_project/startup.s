@@ -1,6 +1,7 @@
 /* startup.s — STM32F303VCT6 (STM32F3x) minimal startup
  * Matches Stage3 linker.ld symbols:
  *   _estack, _sidata, _sdata, _edata, _sbss, _ebss
+ *   _siccm, _sccm, _eccm, _sccm_bss, _eccm_bss
  */
 
 .syntax unified
@@ -79,6 +80,29 @@ Reset_Handler:
   b 4b
 
 6:
+  /* Copy .ccm (code + data) from FLASH to CCM RAM */
+  ldr r0, =_siccm
+  ldr r1, =_sccm
+  ldr r2, =_eccm
+8:
+  cmp r1, r2
+  bcs 9f
+  ldr r3, [r0], #4
+  str r3, [r1], #4
+  b 8b
+
+9:
+  /* Zero .ccm_bss */
+  ldr r0, =_sccm_bss
+  ldr r1, =_eccm_bss
+  movs r2, #0
+10:
+  cmp r0, r1
+  bcs 11f
+  str r2, [r0], #4
+  b 10b
+
+11:
   /* Call main() */
   bl main
 
@@ -88,6 +112,8 @@ Reset_Handler:
 
 /* Weak aliases for handlers */
 .section .text.Default_Handler,"ax",%progbits
+.type Default_Handler, %function
+.thumb_func
 Default_Handler:
   b .
 